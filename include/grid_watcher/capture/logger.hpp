@@ -4,23 +4,75 @@
 
 #include "../scada/types.hpp"
 #include "../performance/lock_free.hpp"
+#include "../performance/parking.hpp"
 #include <thread>
+#include <array>
 #include <atomic>
 #include <fstream>
 #include <iostream>
 #include <iomanip>
 #include <sstream>
 #include <string>
-#include <optional>
 
 namespace gw::capture {
 
     // ========================================================================
-    // Log Entry Structure
+    // Log Sources and Message Catalog
+    // ========================================================================
+    // Producers enqueue enum IDs, not strings: the record stays a fixed-size
+    // POD and the hot path (threat logging during an attack storm) never
+    // touches the heap. All text lives in the catalog below and is rendered
+    // on the writer thread only.
+
+    enum class LogSource : uint8_t {
+        GENERAL = 0,
+        GRID_WATCHER = 1,
+        MANUAL_CONTROL = 2,
+        THREAT_DETECTOR = 3,
+        MITIGATION = 4,
+        CLEANUP = 5,
+        MONITOR = 6
+    };
+
+    enum class LogMessage : uint8_t {
+        NONE = 0,
+        ENGINE_INITIALIZED = 1,     // "Grid-Watcher initialized successfully"
+        ENGINE_ALREADY_RUNNING = 2,
+        ENGINE_STARTED = 3,
+        ENGINE_STOPPING = 4,
+        IP_BLOCKED_MANUAL = 5,      // arg_ip
+        IP_UNBLOCKED_MANUAL = 6,    // arg_ip
+        IP_WHITELISTED = 7,         // arg_ip
+        IP_UNWHITELISTED = 8,       // arg_ip
+        THREAT_DETECTED = 9,        // threat payload
+        MITIGATION_BLOCK = 10,      // threat payload
+        MITIGATION_APPLIED = 11,    // threat payload
+        CLEANUP_COMPLETED = 12,     // counts[0] = stale IPs evicted
+        MONITOR_STATS = 13,         // counts[0..2] = pkts/threats/blocks,
+                                    // values[0..2] = pps / threats-per-min /
+                                    //                avg latency us
+        BLOCKLIST_RESTORED = 14,    // counts[0] = blocks restored from journal
+        SUBNET_BLOCKED_MANUAL = 15,   // arg_ip = prefix, counts[0] = length
+        SUBNET_UNBLOCKED_MANUAL = 16, // arg_ip = prefix, counts[0] = length
+        CONFIG_RELOADED = 17          // counts[0..1] = dos/port-scan thresholds
+    };
+
+    inline const char* to_string(LogSource source) noexcept {
+        switch (source) {
+            case LogSource::GRID_WATCHER: return "GridWatcher";
+            case LogSource::MANUAL_CONTROL: return "ManualControl";
+            case LogSource::THREAT_DETECTOR: return "ThreatDetector";
+            case LogSource::MITIGATION: return "Mitigation";
+            case LogSource::CLEANUP: return "Cleanup";
+            case LogSource::MONITOR: return "Monitor";
+            default: return "General";
+        }
+    }
+
+    // ========================================================================
+    // Log Entry Structure (fixed-size POD - no allocation on enqueue)
     // ========================================================================
     struct LogEntry {
-        using TimePoint = std::chrono::system_clock::time_point;
-        
         enum class Level : uint8_t {
             TRACE = 0,
             DEBUG = 1,
@@ -29,40 +81,47 @@ namespace gw::capture {
             ERROR = 4,
             CRITICAL = 5
         };
-        
-        TimePoint timestamp;
-        Level level;
-        std::string source;
-        std::string message;
-        std::optional<scada::ThreatAlert> threat;
-        
-        LogEntry() noexcept 
-            : timestamp(std::chrono::system_clock::now())
-            , level(Level::INFO) {}
-        
-        LogEntry(Level lvl, std::string src, std::string msg) noexcept
-            : timestamp(std::chrono::system_clock::now())
-            , level(lvl)
-            , source(std::move(src))
-            , message(std::move(msg)) {}
-        
-        std::string toString() const {
-            std::ostringstream oss;
-            auto time_t = std::chrono::system_clock::to_time_t(timestamp);
-            oss << std::put_time(std::localtime(&time_t), "%Y-%m-%d %H:%M:%S");
-            oss << " [" << levelToString(level) << "] [" << source << "] " << message;
-            
-            if (threat) {
-                oss << " | Attack: " << scada::to_string(threat->attack_type);
-                oss << " | Severity: " << scada::to_string(threat->severity);
-                oss << " | Source: " << threat->source_ip.toString();
-                oss << " | Confidence: " << std::fixed << std::setprecision(2) 
-                    << (threat->confidence_score * 100) << "%";
-            }
-            
-            return oss.str();
+
+        uint64_t timestamp_ns{0};   // system_clock ns since epoch
+        Level level{Level::INFO};
+        LogSource source{LogSource::GENERAL};
+        LogMessage message{LogMessage::NONE};
+
+        // Message arguments (interpretation depends on message ID)
+        uint32_t arg_ip{0};
+        uint64_t counts[3]{0, 0, 0};
+        double values[3]{0.0, 0.0, 0.0};
+
+        // Threat payload (valid when has_threat)
+        bool has_threat{false};
+        uint32_t threat_source_ip{0};
+        uint32_t threat_dest_ip{0};
+        scada::AttackType attack_type{scada::AttackType::NONE};
+        scada::ThreatLevel severity{scada::ThreatLevel::INFO};
+        float confidence{0.0f};
+
+        static LogEntry make(Level lvl, LogSource src, LogMessage msg) noexcept {
+            LogEntry entry;
+            entry.timestamp_ns = static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::system_clock::now().time_since_epoch()
+                ).count()
+            );
+            entry.level = lvl;
+            entry.source = src;
+            entry.message = msg;
+            return entry;
+        }
+
+        void setThreat(const scada::ThreatAlert& threat) noexcept {
+            has_threat = true;
+            threat_source_ip = threat.source_ip.to_uint32();
+            threat_dest_ip = threat.dest_ip.to_uint32();
+            attack_type = threat.attack_type;
+            severity = threat.severity;
+            confidence = static_cast<float>(threat.confidence_score);
         }
-        
+
         static const char* levelToString(Level lvl) noexcept {
             switch (lvl) {
                 case Level::TRACE: return "TRACE";
@@ -79,24 +138,39 @@ namespace gw::capture {
     // ========================================================================
     // High-Performance Lock-Free Logger
     // ========================================================================
+    // Enqueue is a POD copy into the ring; the writer thread renders text
+    // from the message catalog and drains the ring in batches with a single
+    // file write (and single flush) per wakeup instead of per line.
     class Logger {
     private:
+        static constexpr size_t WRITE_BATCH = 256;
+
         perf::LockFreeRingBuffer<LogEntry, 8192> log_queue_;
+        perf::ConsumerParker parker_;
         std::thread writer_thread_;
         std::atomic<bool> running_{false};
         std::ofstream log_file_;
         std::string filename_;
         LogEntry::Level min_level_{LogEntry::Level::INFO};
         bool console_output_{true};
-        
+
+        // The ring is strictly SPSC (the producer side keeps a private,
+        // non-atomic cache of the consumer index), but log() is called
+        // from every packet worker plus the cleanup/monitor/API threads.
+        // Serialize producers with the same flag-claim the batch processor
+        // uses for its shared consumer side: the critical section is one
+        // POD copy, and routine packets never log - only threats and
+        // control-plane events contend here.
+        alignas(CACHE_LINE_SIZE) std::atomic_flag push_lock_ = ATOMIC_FLAG_INIT;
+
         // Statistics (cache-aligned)
         alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> logs_written_{0};
         alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> logs_dropped_{0};
-        
+
     public:
-        explicit Logger(const std::string& filename, 
+        explicit Logger(const std::string& filename,
                        LogEntry::Level min_level = LogEntry::Level::INFO,
-                       bool console_output = true) 
+                       bool console_output = true)
             : filename_(filename)
             , min_level_(min_level)
             , console_output_(console_output)
@@ -106,121 +180,249 @@ namespace gw::capture {
                 throw std::runtime_error("Failed to open log file: " + filename_);
             }
         }
-        
+
         ~Logger() {
             stop();
         }
-        
+
         // Prevent copying
         Logger(const Logger&) = delete;
         Logger& operator=(const Logger&) = delete;
-        
+
         void start() {
             if (running_.exchange(true)) return;
             writer_thread_ = std::thread([this]() { writerLoop(); });
         }
-        
+
         void stop() {
             if (!running_.exchange(false)) return;
-            
+
+            parker_.notifyAll(); // release a parked writer
+
             if (writer_thread_.joinable()) {
                 writer_thread_.join();
             }
-            
-            // Flush remaining logs
-            LogEntry entry;
-            while (log_queue_.pop(entry)) {
-                writeLog(entry);
+
+            // Flush remaining logs - the ring can hold far more than one
+            // batch at shutdown, so drain until empty
+            while (drainBatch() > 0) {
             }
-            
+
             log_file_.close();
         }
-        
-        // Generic log method
-        void log(LogEntry::Level level, const std::string& source, 
-                const std::string& message, 
-                std::optional<scada::ThreatAlert> threat = std::nullopt) noexcept {
-            if (level < min_level_) return;
-            
-            LogEntry entry(level, source, message);
-            entry.threat = threat;
-            
-            if (!log_queue_.push(entry)) {
+
+        // Generic log method (HOT PATH - POD copy into the ring, no heap)
+        void log(const LogEntry& entry) noexcept {
+            if (entry.level < min_level_) return;
+
+            // Single producer at a time - see push_lock_
+            while (push_lock_.test_and_set(std::memory_order_acquire)) {
+                // spin: holder is mid-POD-copy
+            }
+            bool pushed = log_queue_.push(entry);
+            push_lock_.clear(std::memory_order_release);
+
+            if (!pushed) {
                 logs_dropped_.fetch_add(1, std::memory_order_relaxed);
+                return;
             }
+            parker_.notifyOne(); // no-op unless the writer is parked
         }
-        
+
         // Convenience methods
-        void trace(const std::string& source, const std::string& message) noexcept {
-            log(LogEntry::Level::TRACE, source, message);
+        void info(LogSource source, LogMessage message) noexcept {
+            log(LogEntry::make(LogEntry::Level::INFO, source, message));
         }
-        
-        void debug(const std::string& source, const std::string& message) noexcept {
-            log(LogEntry::Level::DEBUG, source, message);
+
+        void info(LogSource source, LogMessage message, const net::ipv4& ip) noexcept {
+            auto entry = LogEntry::make(LogEntry::Level::INFO, source, message);
+            entry.arg_ip = ip.to_uint32();
+            log(entry);
         }
-        
-        void info(const std::string& source, const std::string& message) noexcept {
-            log(LogEntry::Level::INFO, source, message);
+
+        void warning(LogSource source, LogMessage message) noexcept {
+            log(LogEntry::make(LogEntry::Level::WARNING, source, message));
         }
-        
-        void warning(const std::string& source, const std::string& message) noexcept {
-            log(LogEntry::Level::WARNING, source, message);
+
+        void warning(LogSource source, LogMessage message, const net::ipv4& ip) noexcept {
+            auto entry = LogEntry::make(LogEntry::Level::WARNING, source, message);
+            entry.arg_ip = ip.to_uint32();
+            log(entry);
+        }
+
+        void warning(LogSource source, LogMessage message,
+                    const scada::ThreatAlert& threat) noexcept {
+            auto entry = LogEntry::make(LogEntry::Level::WARNING, source, message);
+            entry.setThreat(threat);
+            log(entry);
         }
-        
-        void error(const std::string& source, const std::string& message) noexcept {
-            log(LogEntry::Level::ERROR, source, message);
+
+        void error(LogSource source, LogMessage message) noexcept {
+            log(LogEntry::make(LogEntry::Level::ERROR, source, message));
         }
-        
-        void critical(const std::string& source, const std::string& message, 
+
+        void critical(LogSource source, LogMessage message,
                      const scada::ThreatAlert& threat) noexcept {
-            log(LogEntry::Level::CRITICAL, source, message, threat);
+            auto entry = LogEntry::make(LogEntry::Level::CRITICAL, source, message);
+            entry.setThreat(threat);
+            log(entry);
         }
-        
+
         // Configuration
         void setMinLevel(LogEntry::Level level) noexcept {
             min_level_ = level;
         }
-        
+
         void setConsoleOutput(bool enable) noexcept {
             console_output_ = enable;
         }
-        
+
         // Statistics
         uint64_t getLogsWritten() const noexcept {
             return logs_written_.load(std::memory_order_relaxed);
         }
-        
+
         uint64_t getLogsDropped() const noexcept {
             return logs_dropped_.load(std::memory_order_relaxed);
         }
-        
+
     private:
         void writerLoop() {
-            LogEntry entry;
-            
+            // Modest spin: the writer is latency-tolerant, so park quickly
+            // instead of burning cycles between log bursts
+            static constexpr uint32_t WRITER_SPIN = 64;
+
             while (running_.load(std::memory_order_relaxed)) {
-                if (log_queue_.pop(entry)) {
-                    writeLog(entry);
-                } else {
-                    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                if (drainBatch() == 0) {
+                    parker_.parkUntil([this] {
+                        return !running_.load(std::memory_order_relaxed) ||
+                               !log_queue_.empty();
+                    }, WRITER_SPIN);
                 }
             }
         }
-        
-        void writeLog(const LogEntry& entry) {
-            auto log_str = entry.toString();
-            
-            // Write to file
-            log_file_ << log_str << std::endl;
-            log_file_.flush();
-            
-            // Write to console if enabled
-            if (console_output_) {
-                std::cout << log_str << std::endl;
+
+        // Drain up to WRITE_BATCH records, render them into one buffer and
+        // write/flush once. Returns the number of records drained. Entries
+        // leave the ring via one pop_bulk (one index update for the whole
+        // batch) instead of an acquire/release pair per record.
+        size_t drainBatch() {
+            std::ostringstream batch;
+            std::array<LogEntry, WRITE_BATCH> entries;
+            size_t drained = log_queue_.pop_bulk(entries);
+
+            for (size_t i = 0; i < drained; ++i) {
+                formatRecord(batch, entries[i]);
+            }
+
+            if (drained > 0) {
+                auto text = batch.str();
+                log_file_.write(text.data(), static_cast<std::streamsize>(text.size()));
+                log_file_.flush();
+
+                if (console_output_) {
+                    std::cout.write(text.data(), static_cast<std::streamsize>(text.size()));
+                    std::cout.flush();
+                }
+
+                logs_written_.fetch_add(drained, std::memory_order_relaxed);
+            }
+
+            return drained;
+        }
+
+        // Render one record from the message catalog (writer thread only)
+        static void formatRecord(std::ostringstream& oss, const LogEntry& entry) {
+            auto time_t = static_cast<std::time_t>(entry.timestamp_ns / 1000000000ULL);
+            oss << std::put_time(std::localtime(&time_t), "%Y-%m-%d %H:%M:%S");
+            oss << " [" << LogEntry::levelToString(entry.level) << "] ["
+                << to_string(entry.source) << "] ";
+
+            switch (entry.message) {
+                case LogMessage::ENGINE_INITIALIZED:
+                    oss << "Grid-Watcher initialized successfully";
+                    break;
+                case LogMessage::ENGINE_ALREADY_RUNNING:
+                    oss << "Already running";
+                    break;
+                case LogMessage::ENGINE_STARTED:
+                    oss << "Grid-Watcher started - Monitoring SCADA network";
+                    break;
+                case LogMessage::ENGINE_STOPPING:
+                    oss << "Stopping Grid-Watcher...";
+                    break;
+                case LogMessage::IP_BLOCKED_MANUAL:
+                    oss << "IP manually blocked: " << net::ipv4(entry.arg_ip).toString();
+                    break;
+                case LogMessage::IP_UNBLOCKED_MANUAL:
+                    oss << "IP manually unblocked: " << net::ipv4(entry.arg_ip).toString();
+                    break;
+                case LogMessage::IP_WHITELISTED:
+                    oss << "IP added to whitelist: " << net::ipv4(entry.arg_ip).toString();
+                    break;
+                case LogMessage::IP_UNWHITELISTED:
+                    oss << "IP removed from whitelist: " << net::ipv4(entry.arg_ip).toString();
+                    break;
+                case LogMessage::THREAT_DETECTED:
+                    oss << scada::to_string(entry.attack_type) << " detected";
+                    break;
+                case LogMessage::MITIGATION_BLOCK:
+                    oss << "Mitigation: BLOCK_IP for "
+                        << net::ipv4(entry.threat_source_ip).toString()
+                        << " due to " << scada::to_string(entry.attack_type);
+                    break;
+                case LogMessage::MITIGATION_APPLIED:
+                    oss << "Mitigation applied for "
+                        << net::ipv4(entry.threat_source_ip).toString()
+                        << " due to " << scada::to_string(entry.attack_type);
+                    break;
+                case LogMessage::CLEANUP_COMPLETED:
+                    oss << "Periodic cleanup completed (" << entry.counts[0]
+                        << " stale IPs evicted)";
+                    break;
+                case LogMessage::MONITOR_STATS:
+                    oss << "Stats: " << entry.counts[0] << " pkts ("
+                        << std::fixed << std::setprecision(1) << entry.values[0] << " pps) | "
+                        << entry.counts[1] << " threats ("
+                        << std::fixed << std::setprecision(2) << entry.values[1] << "/min) | "
+                        << "Latency: " << std::fixed << std::setprecision(2)
+                        << entry.values[2] << " μs | "
+                        << entry.counts[2] << " active blocks";
+                    break;
+                case LogMessage::BLOCKLIST_RESTORED:
+                    oss << "Restored " << entry.counts[0]
+                        << " active blocks from journal";
+                    break;
+                case LogMessage::SUBNET_BLOCKED_MANUAL:
+                    oss << "Subnet manually blocked: "
+                        << net::ipv4(entry.arg_ip).toString()
+                        << "/" << entry.counts[0];
+                    break;
+                case LogMessage::SUBNET_UNBLOCKED_MANUAL:
+                    oss << "Subnet manually unblocked: "
+                        << net::ipv4(entry.arg_ip).toString()
+                        << "/" << entry.counts[0];
+                    break;
+                case LogMessage::CONFIG_RELOADED:
+                    oss << "Configuration reloaded (dos_threshold="
+                        << entry.counts[0] << ", port_scan_threshold="
+                        << entry.counts[1] << ")";
+                    break;
+                default:
+                    oss << "(unknown message " << static_cast<int>(entry.message) << ")";
+                    break;
+            }
+
+            if (entry.has_threat) {
+                oss << " | Attack: " << scada::to_string(entry.attack_type);
+                oss << " | Severity: " << scada::to_string(entry.severity);
+                oss << " | Source: " << net::ipv4(entry.threat_source_ip).toString();
+                oss << " | Confidence: " << std::fixed << std::setprecision(2)
+                    << (entry.confidence * 100) << "%";
             }
-            
-            logs_written_.fetch_add(1, std::memory_order_relaxed);
+
+            oss << '\n';
         }
     };
 
-} // namespace gw::capture
\ No newline at end of file
+} // namespace gw::capture
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "../performance/sharded_counter.hpp"
+#include "../performance/cache_utils.hpp"
 #include <atomic>
 #include <chrono>
 #include <algorithm>
@@ -17,46 +19,81 @@ namespace gw::capture {
     // ========================================================================
     class LatencyTracker {
     private:
-        static constexpr size_t HISTOGRAM_SIZE = 32;
-        
-        alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> total_samples_{0};
-        alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> total_latency_ns_{0};
-        alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> min_latency_ns_{UINT64_MAX};
-        alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> max_latency_ns_{0};
-        
-        // Simple histogram for percentile calculation
+        // Log-linear histogram: each power of two is split into SUB_BUCKETS
+        // linear sub-buckets (HdrHistogram-style), giving ~12% worst-case
+        // relative error per bucket. The old layout lumped 4x ranges into
+        // one bucket, which made sub-microsecond percentiles meaningless.
+        static constexpr size_t SUB_BUCKET_BITS = 2;
+        static constexpr size_t SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+        static constexpr size_t HISTOGRAM_SIZE = 256;
+        static constexpr size_t NUM_SHARDS = 16;
+
+        // Per-thread-slot shard: samples, sum and min/max all live on the
+        // caller's own cache line, so record() never contends with other
+        // workers (the old min/max CAS loops ping-ponged a shared line).
+        struct alignas(CACHE_LINE_SIZE) Shard {
+            std::atomic<uint64_t> samples{0};
+            std::atomic<uint64_t> total_ns{0};
+            std::atomic<uint64_t> min_ns{UINT64_MAX};
+            std::atomic<uint64_t> max_ns{0};
+        };
+
+        std::array<Shard, NUM_SHARDS> shards_;
+
         std::array<std::atomic<uint64_t>, HISTOGRAM_SIZE> histogram_{};
-        
+
+        static constexpr size_t bucketIndex(uint64_t ns) noexcept {
+            size_t msb = 63 - static_cast<size_t>(__builtin_clzll(ns | 1));
+            if (msb < SUB_BUCKET_BITS) {
+                return static_cast<size_t>(ns); // exact for tiny values
+            }
+            size_t idx = ((msb - SUB_BUCKET_BITS + 1) << SUB_BUCKET_BITS)
+                       + static_cast<size_t>(
+                             (ns >> (msb - SUB_BUCKET_BITS)) & (SUB_BUCKETS - 1));
+            return std::min(idx, HISTOGRAM_SIZE - 1);
+        }
+
+        static constexpr uint64_t bucketLowerBound(size_t idx) noexcept {
+            if (idx < SUB_BUCKETS) return idx;
+            size_t exp = (idx >> SUB_BUCKET_BITS) - 1 + SUB_BUCKET_BITS;
+            uint64_t sub = idx & (SUB_BUCKETS - 1);
+            return (1ULL << exp) + (sub << (exp - SUB_BUCKET_BITS));
+        }
+
+        static constexpr uint64_t bucketWidth(size_t idx) noexcept {
+            if (idx < SUB_BUCKETS) return 1;
+            size_t exp = (idx >> SUB_BUCKET_BITS) - 1 + SUB_BUCKET_BITS;
+            return 1ULL << (exp - SUB_BUCKET_BITS);
+        }
+
     public:
         LatencyTracker() {
             for (auto& bucket : histogram_) {
                 bucket.store(0, std::memory_order_relaxed);
             }
         }
-        
+
         void record(std::chrono::nanoseconds latency) noexcept {
             uint64_t ns = latency.count();
-            
-            total_samples_.fetch_add(1, std::memory_order_relaxed);
-            total_latency_ns_.fetch_add(ns, std::memory_order_relaxed);
-            
-            // Update min/max
-            uint64_t current_min = min_latency_ns_.load(std::memory_order_relaxed);
-            while (ns < current_min && 
-                   !min_latency_ns_.compare_exchange_weak(current_min, ns, 
-                                                          std::memory_order_relaxed)) {}
-            
-            uint64_t current_max = max_latency_ns_.load(std::memory_order_relaxed);
-            while (ns > current_max && 
-                   !max_latency_ns_.compare_exchange_weak(current_max, ns, 
-                                                          std::memory_order_relaxed)) {}
-            
-            // Update histogram (logarithmic buckets)
-            size_t bucket = std::min(static_cast<size_t>(63 - __builtin_clzll(ns | 1)) / 2, 
-                                    HISTOGRAM_SIZE - 1);
-            histogram_[bucket].fetch_add(1, std::memory_order_relaxed);
+            Shard& shard = shards_[perf::threadShardSlot() % NUM_SHARDS];
+
+            shard.samples.fetch_add(1, std::memory_order_relaxed);
+            shard.total_ns.fetch_add(ns, std::memory_order_relaxed);
+
+            // Shard-local min/max - single-writer, so the CAS never spins
+            uint64_t current_min = shard.min_ns.load(std::memory_order_relaxed);
+            while (ns < current_min &&
+                   !shard.min_ns.compare_exchange_weak(current_min, ns,
+                                                       std::memory_order_relaxed)) {}
+
+            uint64_t current_max = shard.max_ns.load(std::memory_order_relaxed);
+            while (ns > current_max &&
+                   !shard.max_ns.compare_exchange_weak(current_max, ns,
+                                                       std::memory_order_relaxed)) {}
+
+            histogram_[bucketIndex(ns)].fetch_add(1, std::memory_order_relaxed);
         }
-        
+
         struct Stats {
             uint64_t samples;
             uint64_t min_ns;
@@ -64,19 +101,47 @@ namespace gw::capture {
             double avg_ns;
             double avg_us;
             double avg_ms;
+            double p50_ns;
+            double p90_ns;
+            double p99_ns;
+            double p999_ns;
         };
-        
+
         Stats getStats() const noexcept {
             Stats stats{};
-            stats.samples = total_samples_.load(std::memory_order_relaxed);
-            
+
+            // Merge shards (read side pays the cross-core cost, not record)
+            uint64_t total = 0;
+            uint64_t merged_min = UINT64_MAX;
+            uint64_t merged_max = 0;
+            for (const auto& shard : shards_) {
+                stats.samples += shard.samples.load(std::memory_order_relaxed);
+                total += shard.total_ns.load(std::memory_order_relaxed);
+                merged_min = std::min(merged_min,
+                                      shard.min_ns.load(std::memory_order_relaxed));
+                merged_max = std::max(merged_max,
+                                      shard.max_ns.load(std::memory_order_relaxed));
+            }
+
             if (stats.samples > 0) {
-                stats.min_ns = min_latency_ns_.load(std::memory_order_relaxed);
-                stats.max_ns = max_latency_ns_.load(std::memory_order_relaxed);
-                uint64_t total = total_latency_ns_.load(std::memory_order_relaxed);
+                stats.min_ns = merged_min;
+                stats.max_ns = merged_max;
                 stats.avg_ns = static_cast<double>(total) / stats.samples;
                 stats.avg_us = stats.avg_ns / 1000.0;
                 stats.avg_ms = stats.avg_us / 1000.0;
+
+                // Snapshot the histogram once, then walk it for each quantile
+                std::array<uint64_t, HISTOGRAM_SIZE> snapshot;
+                uint64_t count = 0;
+                for (size_t i = 0; i < HISTOGRAM_SIZE; ++i) {
+                    snapshot[i] = histogram_[i].load(std::memory_order_relaxed);
+                    count += snapshot[i];
+                }
+
+                stats.p50_ns = percentileFrom(snapshot, count, 0.50, stats);
+                stats.p90_ns = percentileFrom(snapshot, count, 0.90, stats);
+                stats.p99_ns = percentileFrom(snapshot, count, 0.99, stats);
+                stats.p999_ns = percentileFrom(snapshot, count, 0.999, stats);
             } else {
                 stats.min_ns = 0;
                 stats.max_ns = 0;
@@ -84,19 +149,69 @@ namespace gw::capture {
                 stats.avg_us = 0.0;
                 stats.avg_ms = 0.0;
             }
-            
+
             return stats;
         }
-        
+
+        // Cumulative samples at or below the given latency (for Prometheus
+        // histogram exposition - bound is rounded up to a bucket edge)
+        uint64_t countAtOrBelow(uint64_t ns) const noexcept {
+            size_t limit = bucketIndex(ns);
+            uint64_t count = 0;
+            for (size_t i = 0; i <= limit; ++i) {
+                count += histogram_[i].load(std::memory_order_relaxed);
+            }
+            return count;
+        }
+
+        uint64_t totalLatencyNs() const noexcept {
+            uint64_t total = 0;
+            for (const auto& shard : shards_) {
+                total += shard.total_ns.load(std::memory_order_relaxed);
+            }
+            return total;
+        }
+
         void reset() noexcept {
-            total_samples_.store(0, std::memory_order_relaxed);
-            total_latency_ns_.store(0, std::memory_order_relaxed);
-            min_latency_ns_.store(UINT64_MAX, std::memory_order_relaxed);
-            max_latency_ns_.store(0, std::memory_order_relaxed);
+            for (auto& shard : shards_) {
+                shard.samples.store(0, std::memory_order_relaxed);
+                shard.total_ns.store(0, std::memory_order_relaxed);
+                shard.min_ns.store(UINT64_MAX, std::memory_order_relaxed);
+                shard.max_ns.store(0, std::memory_order_relaxed);
+            }
             for (auto& bucket : histogram_) {
                 bucket.store(0, std::memory_order_relaxed);
             }
         }
+
+    private:
+        // Quantile estimate with linear interpolation inside the bucket,
+        // clamped to the observed min/max
+        static double percentileFrom(const std::array<uint64_t, HISTOGRAM_SIZE>& hist,
+                                    uint64_t count, double quantile,
+                                    const Stats& stats) noexcept {
+            if (count == 0) return 0.0;
+
+            double rank = quantile * static_cast<double>(count);
+            uint64_t cumulative = 0;
+
+            for (size_t i = 0; i < HISTOGRAM_SIZE; ++i) {
+                if (hist[i] == 0) continue;
+                cumulative += hist[i];
+
+                if (static_cast<double>(cumulative) >= rank) {
+                    double into_bucket = rank - static_cast<double>(cumulative - hist[i]);
+                    double estimate = static_cast<double>(bucketLowerBound(i))
+                                    + static_cast<double>(bucketWidth(i))
+                                        * (into_bucket / static_cast<double>(hist[i]));
+                    return std::clamp(estimate,
+                                      static_cast<double>(stats.min_ns),
+                                      static_cast<double>(stats.max_ns));
+                }
+            }
+
+            return static_cast<double>(stats.max_ns);
+        }
     };
 
     // ========================================================================
@@ -105,22 +220,27 @@ namespace gw::capture {
     class ThroughputTracker {
     private:
         static constexpr size_t WINDOW_SIZE = 60; // 60 seconds window
+        static constexpr size_t NUM_SHARDS = 16;
         
-        struct Window {
+        // One window set per thread slot: within any given second all
+        // workers used to hammer the same slot, which was the dominant
+        // source of cross-core traffic here. Each shard's window fits a
+        // cache line, so record() stays on the worker's own lines.
+        struct alignas(CACHE_LINE_SIZE) Window {
             std::atomic<uint64_t> packets{0};
             std::atomic<uint64_t> bytes{0};
             std::atomic<uint64_t> timestamp_sec{0};
         };
         
-        std::array<Window, WINDOW_SIZE> windows_;
-        alignas(CACHE_LINE_SIZE) std::atomic<size_t> current_idx_{0};
+        std::array<std::array<Window, WINDOW_SIZE>, NUM_SHARDS> shards_;
         
     public:
         void record(uint64_t bytes) noexcept {
-            auto now_sec = std::chrono::system_clock::now().time_since_epoch().count() / 1000000000ULL;
+            // Coarse clock: per-second buckets need nothing finer
+            auto now_sec = perf::CoarseClock::systemNs() / 1000000000ULL;
             size_t idx = now_sec % WINDOW_SIZE;
             
-            auto& window = windows_[idx];
+            auto& window = shards_[perf::threadShardSlot() % NUM_SHARDS][idx];
             
             // Reset window if timestamp changed
             uint64_t expected_ts = window.timestamp_sec.load(std::memory_order_relaxed);
@@ -151,14 +271,20 @@ namespace gw::capture {
             
             for (size_t i = 0; i < std::min(window_sec, WINDOW_SIZE); ++i) {
                 size_t idx = (now_sec - i) % WINDOW_SIZE;
-                const auto& window = windows_[idx];
+                bool second_valid = false;
                 
-                uint64_t ts = window.timestamp_sec.load(std::memory_order_relaxed);
-                if (ts >= now_sec - window_sec) {
-                    total_packets += window.packets.load(std::memory_order_relaxed);
-                    total_bytes += window.bytes.load(std::memory_order_relaxed);
-                    valid_windows++;
+                for (const auto& shard : shards_) {
+                    const auto& window = shard[idx];
+                    
+                    uint64_t ts = window.timestamp_sec.load(std::memory_order_relaxed);
+                    if (ts >= now_sec - window_sec) {
+                        total_packets += window.packets.load(std::memory_order_relaxed);
+                        total_bytes += window.bytes.load(std::memory_order_relaxed);
+                        second_valid = true;
+                    }
                 }
+                
+                if (second_valid) valid_windows++;
             }
             
             Stats stats{};
@@ -0,0 +1,394 @@
+#pragma once
+
+// ============================================================================
+// PACKET_MMAP (TPACKET_V3) capture backend - Linux only.
+//
+// Frames land in a shared memory-mapped ring, so packets reach user space
+// with zero copies and one poll() wakeup per block instead of one syscall
+// per packet. A classic BPF program attached to the socket keeps everything
+// but TCP traffic on the monitored port out of the ring entirely.
+//
+// Same surface as PacketCapture (start/stop/getStats) so the CLI can pick
+// a backend at runtime and fall back to libpcap gracefully.
+// ============================================================================
+
+#ifdef __linux__
+
+#include <sys/socket.h>
+#include <sys/mman.h>
+#include <sys/ioctl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <net/if.h>
+#include <netinet/in.h>
+#include <linux/if_packet.h>
+#include <linux/if_ether.h>
+#include <linux/filter.h>
+
+#include "../grid_watcher.hpp"
+#include <string>
+#include <atomic>
+#include <thread>
+#include <iostream>
+#include <cstring>
+#include <cstdlib>
+
+namespace gw::capture {
+
+class MmapCapture {
+private:
+    // Ring geometry: 64 blocks x 4MB = 256MB of kernel/user shared buffer
+    static constexpr unsigned int BLOCK_SIZE = 1 << 22;
+    static constexpr unsigned int BLOCK_COUNT = 64;
+    static constexpr unsigned int FRAME_SIZE = 2048;
+    static constexpr unsigned int BLOCK_TIMEOUT_MS = 100;
+
+    int fd_{-1};
+    uint8_t* ring_{nullptr};
+    size_t ring_size_{0};
+    std::atomic<bool> running_{false};
+    std::thread capture_thread_;
+    scada::GridWatcher& watcher_;
+    std::string interface_name_;
+
+    // Statistics
+    alignas(64) std::atomic<uint64_t> packets_captured_{0};
+    alignas(64) std::atomic<uint64_t> packets_processed_{0};
+    alignas(64) std::atomic<uint64_t> packets_dropped_{0};
+
+public:
+    explicit MmapCapture(scada::GridWatcher& watcher)
+        : watcher_(watcher) {}
+
+    ~MmapCapture() {
+        stop();
+    }
+
+    MmapCapture(const MmapCapture&) = delete;
+    MmapCapture& operator=(const MmapCapture&) = delete;
+
+    // ========================================================================
+    // Start Capturing
+    // ========================================================================
+    // The filter string is accepted for interface parity with PacketCapture,
+    // but without libpcap there is no BPF compiler - only the "tcp port N"
+    // form is honored (the port is extracted; anything else falls back to
+    // the default Modbus port 502).
+    bool start(const std::string& interface = "any",
+               const std::string& filter = "tcp port 502") {
+
+        interface_name_ = interface;
+        uint16_t port = extractPort(filter);
+
+        std::cout << "\n[MMAP] Opening interface: " << interface << "\n";
+        std::cout << "[MMAP] Kernel filter: tcp port " << port << "\n";
+
+        fd_ = socket(AF_PACKET, SOCK_RAW, htons(ETH_P_IP));
+        if (fd_ < 0) {
+            std::cerr << "[ERROR] socket(AF_PACKET): " << strerror(errno) << "\n";
+            std::cerr << "\n💡 Tip: Run as root or with CAP_NET_RAW\n";
+            return false;
+        }
+
+        // Attach the kernel filter BEFORE binding so no stray packets are
+        // queued while we set up the ring
+        if (!attachFilter(port)) {
+            cleanupSocket();
+            return false;
+        }
+
+        int version = TPACKET_V3;
+        if (setsockopt(fd_, SOL_PACKET, PACKET_VERSION,
+                       &version, sizeof(version)) < 0) {
+            std::cerr << "[ERROR] PACKET_VERSION: " << strerror(errno) << "\n";
+            cleanupSocket();
+            return false;
+        }
+
+        struct tpacket_req3 req{};
+        req.tp_block_size = BLOCK_SIZE;
+        req.tp_block_nr = BLOCK_COUNT;
+        req.tp_frame_size = FRAME_SIZE;
+        req.tp_frame_nr = (BLOCK_SIZE / FRAME_SIZE) * BLOCK_COUNT;
+        req.tp_retire_blk_tov = BLOCK_TIMEOUT_MS;
+        req.tp_feature_req_word = TP_FT_REQ_FILL_RXHASH;
+
+        if (setsockopt(fd_, SOL_PACKET, PACKET_RX_RING,
+                       &req, sizeof(req)) < 0) {
+            std::cerr << "[ERROR] PACKET_RX_RING: " << strerror(errno) << "\n";
+            cleanupSocket();
+            return false;
+        }
+
+        ring_size_ = static_cast<size_t>(req.tp_block_size) * req.tp_block_nr;
+        ring_ = static_cast<uint8_t*>(
+            mmap(nullptr, ring_size_, PROT_READ | PROT_WRITE,
+                 MAP_SHARED | MAP_LOCKED, fd_, 0)
+        );
+
+        if (ring_ == MAP_FAILED) {
+            // Retry without locking pages (may fail under RLIMIT_MEMLOCK)
+            ring_ = static_cast<uint8_t*>(
+                mmap(nullptr, ring_size_, PROT_READ | PROT_WRITE,
+                     MAP_SHARED, fd_, 0)
+            );
+        }
+
+        if (ring_ == MAP_FAILED) {
+            std::cerr << "[ERROR] mmap ring: " << strerror(errno) << "\n";
+            ring_ = nullptr;
+            cleanupSocket();
+            return false;
+        }
+
+        // Bind to the requested interface (ifindex 0 = all interfaces)
+        struct sockaddr_ll addr{};
+        addr.sll_family = AF_PACKET;
+        addr.sll_protocol = htons(ETH_P_IP);
+        addr.sll_ifindex = 0;
+
+        if (interface != "any") {
+            addr.sll_ifindex = static_cast<int>(if_nametoindex(interface.c_str()));
+            if (addr.sll_ifindex == 0) {
+                std::cerr << "[ERROR] Unknown interface: " << interface << "\n";
+                cleanupRing();
+                cleanupSocket();
+                return false;
+            }
+        }
+
+        if (bind(fd_, reinterpret_cast<struct sockaddr*>(&addr),
+                 sizeof(addr)) < 0) {
+            std::cerr << "[ERROR] bind: " << strerror(errno) << "\n";
+            cleanupRing();
+            cleanupSocket();
+            return false;
+        }
+
+        running_ = true;
+        capture_thread_ = std::thread([this]() { captureLoop(); });
+
+        std::cout << "[MMAP] ✓ Successfully started (TPACKET_V3, "
+                  << (ring_size_ / (1024 * 1024)) << " MB ring)\n";
+        std::cout << "[MMAP] Listening for packets...\n\n";
+
+        return true;
+    }
+
+    // ========================================================================
+    // Stop Capturing
+    // ========================================================================
+    void stop() {
+        if (running_.exchange(false)) {
+            std::cout << "\n[MMAP] Stopping...\n";
+
+            if (capture_thread_.joinable()) {
+                capture_thread_.join();
+            }
+
+            if (fd_ >= 0) {
+                struct tpacket_stats_v3 stats{};
+                socklen_t len = sizeof(stats);
+                if (getsockopt(fd_, SOL_PACKET, PACKET_STATISTICS,
+                               &stats, &len) == 0) {
+                    std::cout << "[MMAP] Ring Stats:\n";
+                    std::cout << "  Received:  " << stats.tp_packets << " packets\n";
+                    std::cout << "  Dropped:   " << stats.tp_drops << " packets\n";
+                }
+            }
+
+            cleanupRing();
+            cleanupSocket();
+
+            std::cout << "[MMAP] ✓ Stopped\n";
+            std::cout << "\nCapture Statistics:\n";
+            std::cout << "  Captured:  " << packets_captured_.load() << " packets\n";
+            std::cout << "  Processed: " << packets_processed_.load() << " packets\n";
+            std::cout << "  Dropped:   " << packets_dropped_.load() << " packets\n";
+        }
+    }
+
+    // ========================================================================
+    // Get Statistics (same shape as PacketCapture::Stats)
+    // ========================================================================
+    struct Stats {
+        uint64_t packets_captured;
+        uint64_t packets_processed;
+        uint64_t packets_dropped;
+    };
+
+    Stats getStats() const noexcept {
+        return Stats{
+            packets_captured_.load(std::memory_order_relaxed),
+            packets_processed_.load(std::memory_order_relaxed),
+            packets_dropped_.load(std::memory_order_relaxed)
+        };
+    }
+
+private:
+    // ========================================================================
+    // Classic BPF: "ethertype IPv4 && proto TCP && !frag && port == N"
+    // ========================================================================
+    bool attachFilter(uint16_t port) {
+        struct sock_filter code[] = {
+            { 0x28, 0, 0, 12 },          // ldh [12]           ; ethertype
+            { 0x15, 0, 10, 0x0800 },     // jne IPv4 -> reject
+            { 0x30, 0, 0, 23 },          // ldb [23]           ; ip protocol
+            { 0x15, 0, 8, 6 },           // jne TCP -> reject
+            { 0x28, 0, 0, 20 },          // ldh [20]           ; frag offset
+            { 0x45, 6, 0, 0x1fff },      // jset frag -> reject
+            { 0xb1, 0, 0, 14 },          // ldxb 4*([14]&0xf)  ; ip hdr len
+            { 0x48, 0, 0, 14 },          // ldh [x+14]         ; src port
+            { 0x15, 2, 0, port },        // jeq port -> accept
+            { 0x48, 0, 0, 16 },          // ldh [x+16]         ; dst port
+            { 0x15, 0, 1, port },        // jne port -> reject
+            { 0x06, 0, 0, 0xffffffff },  // accept: ret all
+            { 0x06, 0, 0, 0 },           // reject: ret 0
+        };
+
+        struct sock_fprog prog{};
+        prog.len = sizeof(code) / sizeof(code[0]);
+        prog.filter = code;
+
+        if (setsockopt(fd_, SOL_SOCKET, SO_ATTACH_FILTER,
+                       &prog, sizeof(prog)) < 0) {
+            std::cerr << "[ERROR] SO_ATTACH_FILTER: " << strerror(errno) << "\n";
+            return false;
+        }
+
+        return true;
+    }
+
+    static uint16_t extractPort(const std::string& filter) noexcept {
+        // Honor the trailing port number of a "tcp port N" expression
+        size_t pos = filter.find_last_not_of("0123456789");
+        if (pos != std::string::npos && pos + 1 < filter.size()) {
+            unsigned long port = std::strtoul(filter.c_str() + pos + 1, nullptr, 10);
+            if (port > 0 && port <= 65535) {
+                return static_cast<uint16_t>(port);
+            }
+        }
+        return 502; // default: Modbus TCP
+    }
+
+    // ========================================================================
+    // Main Capture Loop - walk retired blocks, release them to the kernel
+    // ========================================================================
+    void captureLoop() {
+        unsigned int block_idx = 0;
+        struct pollfd pfd{};
+        pfd.fd = fd_;
+        pfd.events = POLLIN | POLLERR;
+
+        while (running_.load(std::memory_order_relaxed)) {
+            auto* desc = reinterpret_cast<struct tpacket_block_desc*>(
+                ring_ + static_cast<size_t>(block_idx) * BLOCK_SIZE
+            );
+
+            if ((desc->hdr.bh1.block_status & TP_STATUS_USER) == 0) {
+                // Block still owned by the kernel - wait for it to retire
+                poll(&pfd, 1, static_cast<int>(BLOCK_TIMEOUT_MS));
+                continue;
+            }
+
+            walkBlock(desc);
+
+            // Hand the block back to the kernel
+            desc->hdr.bh1.block_status = TP_STATUS_KERNEL;
+            __sync_synchronize();
+
+            block_idx = (block_idx + 1) % BLOCK_COUNT;
+        }
+    }
+
+    void walkBlock(struct tpacket_block_desc* desc) {
+        uint32_t num_pkts = desc->hdr.bh1.num_pkts;
+
+        auto* hdr = reinterpret_cast<struct tpacket3_hdr*>(
+            reinterpret_cast<uint8_t*>(desc) + desc->hdr.bh1.offset_to_first_pkt
+        );
+
+        for (uint32_t i = 0; i < num_pkts; ++i) {
+            packets_captured_.fetch_add(1, std::memory_order_relaxed);
+
+            const uint8_t* frame =
+                reinterpret_cast<const uint8_t*>(hdr) + hdr->tp_mac;
+
+            try {
+                if (processFrame(frame, hdr->tp_snaplen)) {
+                    packets_processed_.fetch_add(1, std::memory_order_relaxed);
+                } else {
+                    packets_dropped_.fetch_add(1, std::memory_order_relaxed);
+                }
+            } catch (...) {
+                packets_dropped_.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            hdr = reinterpret_cast<struct tpacket3_hdr*>(
+                reinterpret_cast<uint8_t*>(hdr) + hdr->tp_next_offset
+            );
+        }
+    }
+
+    // ========================================================================
+    // Parse Raw Frame (Ethernet -> IP -> TCP -> Payload) - zero-copy
+    // ========================================================================
+    bool processFrame(const uint8_t* frame, uint32_t frame_len) {
+        if (frame_len < 34) return false; // Ethernet + IP min
+
+        const uint8_t* ip_header = frame + 14;
+
+        uint8_t version = (ip_header[0] >> 4) & 0x0F;
+        if (version != 4) return false;
+
+        uint8_t ip_header_len = (ip_header[0] & 0x0F) * 4;
+        if (ip_header_len < 20) return false;
+
+        uint8_t protocol = ip_header[9];
+        if (protocol != 6) return false; // Not TCP
+
+        net::ipv4 src_ip({ip_header[12], ip_header[13], ip_header[14], ip_header[15]});
+        net::ipv4 dst_ip({ip_header[16], ip_header[17], ip_header[18], ip_header[19]});
+
+        if (frame_len < 14u + ip_header_len + 20u) return false;
+
+        const uint8_t* tcp_header = ip_header + ip_header_len;
+
+        uint16_t src_port = (tcp_header[0] << 8) | tcp_header[1];
+        uint16_t dst_port = (tcp_header[2] << 8) | tcp_header[3];
+
+        uint8_t tcp_header_len = ((tcp_header[12] >> 4) & 0x0F) * 4;
+        if (tcp_header_len < 20) return false;
+
+        size_t payload_offset = 14u + ip_header_len + tcp_header_len;
+        if (frame_len <= payload_offset) return false; // No payload
+
+        // ZERO-COPY: the span points into the mmap'd ring; it is only valid
+        // until the block is released back to the kernel
+        std::span<const std::byte> data(
+            reinterpret_cast<const std::byte*>(frame + payload_offset),
+            frame_len - payload_offset
+        );
+
+        return watcher_.processPacket(data, src_ip, dst_ip, src_port, dst_port);
+    }
+
+    void cleanupRing() {
+        if (ring_) {
+            munmap(ring_, ring_size_);
+            ring_ = nullptr;
+            ring_size_ = 0;
+        }
+    }
+
+    void cleanupSocket() {
+        if (fd_ >= 0) {
+            close(fd_);
+            fd_ = -1;
+        }
+    }
+};
+
+} // namespace gw::capture
+
+#endif // __linux__
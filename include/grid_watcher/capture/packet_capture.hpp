@@ -202,53 +202,63 @@ private:
     // ========================================================================
     // Main Capture Loop (runs in background thread)
     // ========================================================================
+    // Max packets drained per pcap_dispatch call (one syscall round-trip
+    // serves a whole burst instead of one packet)
+    static constexpr int DISPATCH_BATCH = 256;
+
     void captureLoop() {
-        struct pcap_pkthdr* header;
-        const u_char* packet;
-        
         while (running_.load(std::memory_order_relaxed)) {
-            int res = pcap_next_ex(handle_, &header, &packet);
-            
-            if (res == 1) {
-                // Packet captured successfully
-                packets_captured_.fetch_add(1, std::memory_order_relaxed);
-                
-                try {
-                    if (processRawPacket(header, packet)) {
-                        packets_processed_.fetch_add(1, std::memory_order_relaxed);
-                    } else {
-                        packets_dropped_.fetch_add(1, std::memory_order_relaxed);
-                    }
-                } catch (...) {
-                    packets_dropped_.fetch_add(1, std::memory_order_relaxed);
-                }
-                
-            } else if (res == 0) {
-                // Timeout, no packet
+            int res = pcap_dispatch(
+                handle_,
+                DISPATCH_BATCH,
+                &PacketCapture::dispatchCallback,
+                reinterpret_cast<u_char*>(this)
+            );
+
+            if (res == 0) {
+                // Timeout, no packets in the buffer
                 std::this_thread::yield();
             } else if (res == -1) {
                 // Error
-                std::cerr << "[ERROR] pcap_next_ex: " << pcap_geterr(handle_) << "\n";
+                std::cerr << "[ERROR] pcap_dispatch: " << pcap_geterr(handle_) << "\n";
                 break;
             } else if (res == -2) {
-                // EOF (should not happen in live capture)
+                // pcap_breakloop() was called
                 break;
             }
         }
     }
+
+    // Per-packet callback invoked by pcap_dispatch for each packet in a burst
+    static void dispatchCallback(u_char* user, const pcap_pkthdr* header,
+                                 const u_char* packet) {
+        auto* self = reinterpret_cast<PacketCapture*>(user);
+
+        self->packets_captured_.fetch_add(1, std::memory_order_relaxed);
+
+        try {
+            if (self->processRawPacket(header, packet)) {
+                self->packets_processed_.fetch_add(1, std::memory_order_relaxed);
+            } else {
+                self->packets_dropped_.fetch_add(1, std::memory_order_relaxed);
+            }
+        } catch (...) {
+            self->packets_dropped_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
     
     // ========================================================================
     // Parse Raw Packet (Ethernet -> IP -> TCP -> Payload)
     // ========================================================================
     bool processRawPacket(const pcap_pkthdr* header, const u_char* packet) {
         // Minimum packet size check
-        if (header->len < 14) return false; // Ethernet header
+        if (header->caplen < 14) return false; // Ethernet header
         
         // Parse Ethernet header (14 bytes)
         // We skip it since we only care about IP layer
         
         // Parse IP header (starts at offset 14)
-        if (header->len < 34) return false; // Ethernet + IP min
+        if (header->caplen < 34) return false; // Ethernet + IP min
         
         const u_char* ip_header = packet + 14;
         
@@ -269,7 +279,7 @@ private:
         net::ipv4 dst_ip({ip_header[16], ip_header[17], ip_header[18], ip_header[19]});
         
         // Parse TCP header
-        if (header->len < 14 + ip_header_len + 20) return false; // Not enough data
+        if (header->caplen < 14u + ip_header_len + 20u) return false; // Not enough data
         
         const u_char* tcp_header = ip_header + ip_header_len;
         
@@ -281,20 +291,24 @@ private:
         uint8_t tcp_header_len = ((tcp_header[12] >> 4) & 0x0F) * 4;
         if (tcp_header_len < 20) return false; // Invalid
         
-        // Calculate payload offset and length
+        // Calculate payload offset and length (bounded by caplen - only the
+        // captured bytes are actually in the pcap buffer)
         size_t payload_offset = 14 + ip_header_len + tcp_header_len;
-        if (header->len <= payload_offset) return false; // No payload
-        
+        if (header->caplen <= payload_offset) return false; // No payload
+
         const u_char* payload = packet + payload_offset;
-        size_t payload_len = header->len - payload_offset;
-        
-        // Convert payload to std::vector<std::byte>
-        std::vector<std::byte> data(payload_len);
-        std::memcpy(data.data(), payload, payload_len);
-        
+        size_t payload_len = header->caplen - payload_offset;
+
+        // ZERO-COPY: wrap the pcap buffer in a span and hand it straight to
+        // the engine. The span is only valid for the duration of this
+        // callback; processPacket never retains it.
+        std::span<const std::byte> data(
+            reinterpret_cast<const std::byte*>(payload), payload_len
+        );
+
         // Send to Grid-Watcher for analysis
         bool allowed = watcher_.processPacket(data, src_ip, dst_ip, src_port, dst_port);
-        
+
         return allowed;
     }
 };
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../performance/sharded_counter.hpp"
 #include <atomic>
 #include <chrono>
 #include <cstdint>
@@ -11,23 +12,26 @@
 namespace gw::capture {
 
     // ========================================================================
-    // Performance Statistics (Cache-Aligned for Speed)
+    // Performance Statistics (Sharded for Contention-Free Increments)
     // ========================================================================
+    // Counters are sharded per thread slot: every worker increments its own
+    // cache-line-padded block, so concurrent packet workers never share a
+    // counter line. Cross-core traffic only happens on snapshot reads.
     class Statistics {
     private:
-        // Packet counters (cache-aligned to prevent false sharing)
-        alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> packets_processed_{0};
-        alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> packets_allowed_{0};
-        alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> packets_dropped_{0};
-        alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> bytes_processed_{0};
+        // Packet counters
+        perf::ShardedCounter<16> packets_processed_;
+        perf::ShardedCounter<16> packets_allowed_;
+        perf::ShardedCounter<16> packets_dropped_;
+        perf::ShardedCounter<16> bytes_processed_;
         
         // Threat counters
-        alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> threats_detected_{0};
-        alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> threats_mitigated_{0};
+        perf::ShardedCounter<16> threats_detected_;
+        perf::ShardedCounter<16> threats_mitigated_;
         
         // Block counters
-        alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> total_blocks_{0};
-        alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> active_blocks_{0};
+        perf::ShardedCounter<16> total_blocks_;
+        perf::ShardedCounter<16> active_blocks_;
         
         // Timing
         std::chrono::system_clock::time_point start_time_;
@@ -38,49 +42,49 @@ namespace gw::capture {
         
         // Reset statistics
         void reset() noexcept {
-            packets_processed_.store(0, std::memory_order_relaxed);
-            packets_allowed_.store(0, std::memory_order_relaxed);
-            packets_dropped_.store(0, std::memory_order_relaxed);
-            bytes_processed_.store(0, std::memory_order_relaxed);
-            threats_detected_.store(0, std::memory_order_relaxed);
-            threats_mitigated_.store(0, std::memory_order_relaxed);
-            total_blocks_.store(0, std::memory_order_relaxed);
-            active_blocks_.store(0, std::memory_order_relaxed);
+            packets_processed_.reset();
+            packets_allowed_.reset();
+            packets_dropped_.reset();
+            bytes_processed_.reset();
+            threats_detected_.reset();
+            threats_mitigated_.reset();
+            total_blocks_.reset();
+            active_blocks_.reset();
             start_time_ = std::chrono::system_clock::now();
         }
         
-        // Increment operations (hot path - optimized)
+        // Increment operations (hot path - uncontended per-thread lines)
         void incrementPacketsProcessed() noexcept {
-            packets_processed_.fetch_add(1, std::memory_order_relaxed);
+            packets_processed_.increment();
         }
         
         void incrementPacketsAllowed() noexcept {
-            packets_allowed_.fetch_add(1, std::memory_order_relaxed);
+            packets_allowed_.increment();
         }
         
         void incrementPacketsDropped() noexcept {
-            packets_dropped_.fetch_add(1, std::memory_order_relaxed);
+            packets_dropped_.increment();
         }
         
         void addBytesProcessed(uint64_t bytes) noexcept {
-            bytes_processed_.fetch_add(bytes, std::memory_order_relaxed);
+            bytes_processed_.add(bytes);
         }
         
         void incrementThreatsDetected() noexcept {
-            threats_detected_.fetch_add(1, std::memory_order_relaxed);
+            threats_detected_.increment();
         }
         
         void incrementThreatsMitigated() noexcept {
-            threats_mitigated_.fetch_add(1, std::memory_order_relaxed);
+            threats_mitigated_.increment();
         }
         
         void incrementTotalBlocks() noexcept {
-            total_blocks_.fetch_add(1, std::memory_order_relaxed);
-            active_blocks_.fetch_add(1, std::memory_order_relaxed);
+            total_blocks_.increment();
+            active_blocks_.increment();
         }
         
         void decrementActiveBlocks() noexcept {
-            active_blocks_.fetch_sub(1, std::memory_order_relaxed);
+            active_blocks_.decrement();
         }
         
         // Snapshot for reporting
@@ -122,15 +126,15 @@ namespace gw::capture {
         Snapshot getSnapshot() const noexcept {
             Snapshot snap;
             
-            // Atomic reads
-            snap.packets_processed = packets_processed_.load(std::memory_order_relaxed);
-            snap.packets_allowed = packets_allowed_.load(std::memory_order_relaxed);
-            snap.packets_dropped = packets_dropped_.load(std::memory_order_relaxed);
-            snap.bytes_processed = bytes_processed_.load(std::memory_order_relaxed);
-            snap.threats_detected = threats_detected_.load(std::memory_order_relaxed);
-            snap.threats_mitigated = threats_mitigated_.load(std::memory_order_relaxed);
-            snap.total_blocks = total_blocks_.load(std::memory_order_relaxed);
-            snap.active_blocks = active_blocks_.load(std::memory_order_relaxed);
+            // Cross-shard sums (the only place that touches every line)
+            snap.packets_processed = packets_processed_.sum();
+            snap.packets_allowed = packets_allowed_.sum();
+            snap.packets_dropped = packets_dropped_.sum();
+            snap.bytes_processed = bytes_processed_.sum();
+            snap.threats_detected = threats_detected_.sum();
+            snap.threats_mitigated = threats_mitigated_.sum();
+            snap.total_blocks = total_blocks_.sum();
+            snap.active_blocks = active_blocks_.sum();
             
             // Calculate derived metrics
             auto now = std::chrono::system_clock::now();
@@ -153,15 +157,15 @@ namespace gw::capture {
         
         // Individual getters (for specific metrics)
         uint64_t getPacketsProcessed() const noexcept {
-            return packets_processed_.load(std::memory_order_relaxed);
+            return packets_processed_.sum();
         }
         
         uint64_t getThreatsDetected() const noexcept {
-            return threats_detected_.load(std::memory_order_relaxed);
+            return threats_detected_.sum();
         }
         
         uint64_t getActiveBlocks() const noexcept {
-            return active_blocks_.load(std::memory_order_relaxed);
+            return active_blocks_.sum();
         }
         
         std::chrono::seconds getUptime() const noexcept {
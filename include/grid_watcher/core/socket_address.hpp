@@ -28,7 +28,9 @@ namespace gw::net {
 		constexpr void setAddress(const ipv4& address) noexcept { address_ = address ; }
 		constexpr void setPort(uint16_t port) noexcept { port_ = port ; }
 
-		constexpr std::string toString() const noexcept {
+		// Bukan constexpr: std::format tidak bisa dievaluasi compile-time,
+		// dan GCC 12 (tanpa P2448) menolak constexpr di sini
+		std::string toString() const noexcept {
 			return std::format("{}:{}", address_.toString(), port_) ;
 		}
 
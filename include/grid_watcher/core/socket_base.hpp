@@ -10,6 +10,8 @@
 #else
     #include <sys/socket.h>
     #include <arpa/inet.h>
+    #include <netinet/in.h>
+    #include <netinet/tcp.h>
     #include <unistd.h>
     #include <fcntl.h>
     #include <sys/time.h>
@@ -11,11 +11,26 @@
 
 namespace gw::net {
 
+    // Hasil operasi I/O non-blocking (untuk event loop)
+    enum class IoResult {
+        OK,          // Data diterima/terkirim
+        WOULD_BLOCK, // Belum ada data / buffer penuh - coba lagi nanti
+        CLOSED       // Peer menutup koneksi
+    };
+
     class TcpSocket : public BaseSocket {
     private:
         static constexpr size_t MAX_BUFFER_SIZE = 64 * 1024; // 64KB max
         static constexpr size_t DEFAULT_BUFFER_SIZE = 4096;
 
+        friend class TcpListener;
+
+        // Adopsi handle dari accept() - JANGAN create socket baru
+        struct AdoptTag {};
+        TcpSocket(AdoptTag, SocketHandle handle) {
+            handle_ = handle;
+        }
+
     public:
         TcpSocket() {
             create(PF_INET, SOCK_STREAM, IPPROTO_TCP);
@@ -290,6 +305,83 @@ namespace gw::net {
             return result.empty() ? std::nullopt : std::optional<std::string>(result);
         }
 
+        // Non-blocking receive untuk event loop: beda dengan receive(),
+        // WOULD_BLOCK dan CLOSED bisa dibedakan (epoll butuh ini)
+        IoResult tryReceive(std::string& out, size_t bufferSize = DEFAULT_BUFFER_SIZE) {
+            if (!isValid()) {
+                return IoResult::CLOSED;
+            }
+
+            std::vector<char> buffer(std::min(bufferSize, MAX_BUFFER_SIZE));
+
+            int bytesReceived = ::recv(
+                handle_,
+                buffer.data(),
+                static_cast<int>(buffer.size()),
+                0
+            );
+
+            if (bytesReceived > 0) {
+                out.append(buffer.data(), static_cast<size_t>(bytesReceived));
+                return IoResult::OK;
+            }
+
+            if (bytesReceived == 0) {
+                return IoResult::CLOSED; // Peer shutdown
+            }
+
+            #ifdef _WIN32
+            int err = ::WSAGetLastError();
+            if (err == WSAEWOULDBLOCK) {
+                return IoResult::WOULD_BLOCK;
+            }
+            #else
+            if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) {
+                return IoResult::WOULD_BLOCK;
+            }
+            #endif
+
+            return IoResult::CLOSED; // Error lain: anggap koneksi mati
+        }
+
+        // Non-blocking send: jumlah byte terkirim ditulis ke sent_out
+        IoResult trySend(std::string_view data, size_t& sent_out) {
+            sent_out = 0;
+
+            if (!isValid()) {
+                return IoResult::CLOSED;
+            }
+            if (data.empty()) {
+                return IoResult::OK;
+            }
+
+            int sent = ::send(
+                handle_,
+                data.data(),
+                static_cast<int>(std::min(data.size(),
+                    static_cast<size_t>(std::numeric_limits<int>::max()))),
+                0
+            );
+
+            if (sent > 0) {
+                sent_out = static_cast<size_t>(sent);
+                return IoResult::OK;
+            }
+
+            #ifdef _WIN32
+            int err = ::WSAGetLastError();
+            if (err == WSAEWOULDBLOCK) {
+                return IoResult::WOULD_BLOCK;
+            }
+            #else
+            if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) {
+                return IoResult::WOULD_BLOCK;
+            }
+            #endif
+
+            return IoResult::CLOSED;
+        }
+
         // Get remote address (peer info)
         std::optional<SocketAddress> getRemoteAddress() const {
             if (!isValid()) {
@@ -329,4 +421,85 @@ namespace gw::net {
         }
     };
 
+    // Listener untuk koneksi TCP masuk (bind/listen/accept)
+    class TcpListener : public BaseSocket {
+    public:
+        TcpListener() {
+            create(PF_INET, SOCK_STREAM, IPPROTO_TCP);
+        }
+
+        // Bind + listen dalam satu langkah
+        void listen(const SocketAddress& localAddress, int backlog = SOMAXCONN) {
+            if (!isValid()) {
+                throw std::runtime_error("Socket not initialized");
+            }
+
+            setReuseAddress(true); // Restart server tanpa tunggu TIME_WAIT
+
+            sockaddr_in addr{};
+            std::memset(&addr, 0, sizeof(addr));
+            addr.sin_family = AF_INET;
+            addr.sin_port = htons(localAddress.getPort());
+            addr.sin_addr.s_addr = htonl(localAddress.getAddress().to_uint32());
+
+            if (::bind(handle_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+                throw std::system_error(
+                    #ifdef _WIN32
+                    ::WSAGetLastError(),
+                    #else
+                    errno,
+                    #endif
+                    std::system_category(),
+                    "Failed to bind to " + localAddress.toString()
+                );
+            }
+
+            if (::listen(handle_, backlog) != 0) {
+                throw std::system_error(
+                    #ifdef _WIN32
+                    ::WSAGetLastError(),
+                    #else
+                    errno,
+                    #endif
+                    std::system_category(),
+                    "Failed to listen"
+                );
+            }
+        }
+
+        // Accept koneksi baru. nullopt = belum ada (non-blocking mode)
+        std::optional<TcpSocket> accept() {
+            if (!isValid()) {
+                throw std::runtime_error("Socket not initialized");
+            }
+
+            SocketHandle client = ::accept(handle_, nullptr, nullptr);
+
+            if (client == INVALID_SOCKET) {
+                #ifdef _WIN32
+                int err = ::WSAGetLastError();
+                if (err == WSAEWOULDBLOCK) {
+                    return std::nullopt;
+                }
+                #else
+                if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) {
+                    return std::nullopt;
+                }
+                #endif
+
+                throw std::system_error(
+                    #ifdef _WIN32
+                    ::WSAGetLastError(),
+                    #else
+                    errno,
+                    #endif
+                    std::system_category(),
+                    "Failed to accept connection"
+                );
+            }
+
+            return TcpSocket(TcpSocket::AdoptTag{}, client);
+        }
+    };
+
 } // namespace gw::net
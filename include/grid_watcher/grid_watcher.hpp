@@ -8,27 +8,43 @@
 #include "scada/types.hpp"
 #include "scada/config.hpp"
 #include "scada/modbus_parser.hpp"
+#include "scada/protocol_dispatch.hpp"
 #include "scada/behavioral_analyzer.hpp"
 #include "scada/mitigation_engine.hpp"
+#include "scada/alert_journal.hpp"
 #include "capture/logger.hpp"
 #include "capture/statistics.hpp"
 #include "capture/metrics.hpp"
 #include "performance/bloom_filter.hpp"
+#include "performance/stage_profiler.hpp"
 #include "core/ipv4.hpp"
 #include <thread>
 #include <atomic>
 #include <memory>
 #include <span>
+#include <array>
 
 namespace gw::scada {
 
+    // ========================================================================
+    // Packet Descriptor for Batch Processing (non-owning view)
+    // ========================================================================
+    struct PacketView {
+        std::span<const std::byte> data;
+        net::ipv4 source_ip;
+        net::ipv4 dest_ip;
+        uint16_t source_port{0};
+        uint16_t dest_port{0};
+    };
+
     // ========================================================================
     // Main Grid-Watcher Engine (Streamlined & Optimized)
     // ========================================================================
     class GridWatcher {
     private:
-        // Configuration
-        DetectionConfig config_;
+        // Configuration: RCU-published snapshots so thresholds hot-reload
+        // without restarting (and without losing analyzer state)
+        ConfigStore config_;
         
         // Core components
         BehavioralAnalyzer analyzer_;
@@ -38,10 +54,18 @@ namespace gw::scada {
         std::unique_ptr<capture::Logger> logger_;
         capture::Statistics stats_;
         capture::MetricsManager metrics_;
+        AlertJournal alert_journal_;
         
-        // Fast lookup structures (bloom filters for O(1) checks)
-        perf::BloomFilter<8192, 3> blocked_ips_cache_;
-        perf::BloomFilter<8192, 3> whitelisted_ips_cache_;
+        // Fast lookup structures (bloom filters for O(1) checks). Both are
+        // the counting variant so entries can be removed - a plain bloom
+        // filter only grows, which would push every formerly-blocked IP
+        // onto the slow double-check path forever, and would keep a
+        // de-whitelisted IP on the allow path after a config reload.
+        perf::CountingBloomFilter<8192, 3> blocked_ips_cache_;
+        perf::CountingBloomFilter<8192, 3> whitelisted_ips_cache_;
+
+        // Per-stage cycle breakdown (empty stub unless GW_PROFILE_STAGES)
+        perf::StageProfiler stage_profiler_;
         
         // Background threads
         std::atomic<bool> running_{false};
@@ -57,7 +81,7 @@ namespace gw::scada {
             , logger_(std::make_unique<capture::Logger>(log_file))
         {
             // Initialize bloom filters with whitelisted IPs
-            for (const auto& ip : config_.whitelisted_ips) {
+            for (const auto& ip : config.whitelisted_ips) {
                 whitelisted_ips_cache_.add(ip.to_uint32());
             }
             
@@ -67,7 +91,30 @@ namespace gw::scada {
             });
             
             logger_->start();
-            logger_->info("GridWatcher", "Grid-Watcher initialized successfully");
+            logger_->info(capture::LogSource::GRID_WATCHER,
+                          capture::LogMessage::ENGINE_INITIALIZED);
+
+            // Binary alert journal (no-op when not configured): threat
+            // records get their own channel instead of competing with
+            // routine lines for the logger's ring
+            if (!config.alert_journal_path.empty()) {
+                alert_journal_.open(config.alert_journal_path);
+            }
+
+            // Replay the persisted blocklist (no-op when journaling is off),
+            // pre-warming the fast-path cache so restored blocks hit the
+            // bloom filter immediately
+            size_t restored = mitigation_.restoreFromJournal([this](uint32_t ip_key) {
+                blocked_ips_cache_.add(ip_key);
+            });
+            if (restored > 0) {
+                auto entry = capture::LogEntry::make(
+                    capture::LogEntry::Level::INFO,
+                    capture::LogSource::GRID_WATCHER,
+                    capture::LogMessage::BLOCKLIST_RESTORED);
+                entry.counts[0] = restored;
+                logger_->log(entry);
+            }
         }
         
         ~GridWatcher() {
@@ -84,7 +131,8 @@ namespace gw::scada {
         
         void start() {
             if (running_.exchange(true)) {
-                logger_->warning("GridWatcher", "Already running");
+                logger_->warning(capture::LogSource::GRID_WATCHER,
+                                 capture::LogMessage::ENGINE_ALREADY_RUNNING);
                 return;
             }
             
@@ -92,13 +140,15 @@ namespace gw::scada {
             cleanup_thread_ = std::thread([this]() { cleanupLoop(); });
             monitor_thread_ = std::thread([this]() { monitorLoop(); });
             
-            logger_->info("GridWatcher", "Grid-Watcher started - Monitoring SCADA network");
+            logger_->info(capture::LogSource::GRID_WATCHER,
+                          capture::LogMessage::ENGINE_STARTED);
         }
         
         void stop() {
             if (!running_.exchange(false)) return;
             
-            logger_->info("GridWatcher", "Stopping Grid-Watcher...");
+            logger_->info(capture::LogSource::GRID_WATCHER,
+                          capture::LogMessage::ENGINE_STOPPING);
             
             if (cleanup_thread_.joinable()) cleanup_thread_.join();
             if (monitor_thread_.joinable()) monitor_thread_.join();
@@ -122,16 +172,22 @@ namespace gw::scada {
             
             // Update statistics
             stats_.incrementPacketsProcessed();
-            
+
             uint32_t src_ip_int = source_ip.to_uint32();
-            
+
+            // One sampling decision covers every stage of this packet
+            // (constant false when the profiler is compiled out)
+            const bool profile = stage_profiler_.shouldSample();
+            perf::StageTimer fast_timer(
+                stage_profiler_, perf::Stage::FAST_PATH, profile);
+
             // FAST PATH 1: Check whitelist (bloom filter - O(1))
             if (UNLIKELY(whitelisted_ips_cache_.contains(src_ip_int))) {
                 stats_.incrementPacketsAllowed();
                 metrics_.throughput().record(packet_data.size());
                 return true; // ALLOW
             }
-            
+
             // FAST PATH 2: Check blocked IPs (bloom filter - O(1))
             if (UNLIKELY(blocked_ips_cache_.contains(src_ip_int))) {
                 // Double-check with mitigation engine (bloom filter can have false positives)
@@ -141,61 +197,144 @@ namespace gw::scada {
                     return false; // DROP
                 }
             }
-            
-            // Parse packet metadata (minimal parsing for speed)
-            PacketMetadata meta = buildPacketMetadata(
-                packet_data, source_ip, dest_ip, source_port, dest_port
-            );
-            
-            // Check if should drop before analysis (rate limiting)
-            if (mitigation_.shouldDropPacket(meta)) {
+
+            // FAST PATH 3: CIDR blocks (LPM - the /32 bloom cache cannot
+            // represent ranges; skipped entirely when no rules exist)
+            if (UNLIKELY(mitigation_.hasSubnetBlocks()) &&
+                mitigation_.isSubnetBlocked(source_ip)) {
                 stats_.incrementPacketsDropped();
                 recordLatency(start);
                 return false; // DROP
             }
-            
-            // Behavioral analysis (detect threats)
-            auto threat_start = std::chrono::steady_clock::now();
-            auto threats = analyzer_.analyze(meta);
-            metrics_.threatDetectionLatency().record(
-                std::chrono::steady_clock::now() - threat_start
+
+            fast_timer.finish();
+
+            // Slow path: full parse + behavioral analysis + mitigation
+            bool allowed = runDetectionPath(
+                packet_data, source_ip, dest_ip, source_port, dest_port,
+                src_ip_int, /*sample_threat_latency=*/true,
+                /*known_malformed=*/false, profile
             );
-            
-            // Process threats
-            bool should_drop = false;
-            for (const auto& threat : threats) {
-                stats_.incrementThreatsDetected();
-                
-                // Log threat
-                logger_->critical("ThreatDetector", threat.description, threat);
-                
-                // Trigger mitigation
-                auto action = mitigation_.mitigate(threat);
-                
-                // Update bloom filter cache if IP was blocked
-                if (action == MitigationAction::BLOCK_IP) {
-                    blocked_ips_cache_.add(src_ip_int);
+
+            recordLatency(start);
+            return allowed;
+        }
+
+        // Batch version of processPacket: amortizes clock reads across the
+        // whole batch and runs the bloom-filter pre-checks over all packets
+        // before touching the analyzer. Returns a verdict bitmap where bit i
+        // set means packet i is ALLOWED. Batches larger than MAX_BATCH_SIZE
+        // are truncated (callers should submit at most MAX_BATCH_SIZE).
+        static constexpr size_t MAX_BATCH_SIZE = 64;
+
+        [[nodiscard]] uint64_t processPacketBatch(
+            std::span<const PacketView> batch) noexcept
+        {
+            const size_t n = std::min(batch.size(), MAX_BATCH_SIZE);
+            if (UNLIKELY(n == 0)) return 0;
+
+            // Single latency measurement for the whole batch
+            auto start = std::chrono::steady_clock::now();
+
+            // PASS 1: bloom-filter pre-classification (cache-friendly sweep)
+            std::array<uint32_t, MAX_BATCH_SIZE> src_ips;
+            uint64_t whitelisted = 0;
+            uint64_t maybe_blocked = 0;
+
+            for (size_t i = 0; i < n; ++i) {
+                src_ips[i] = batch[i].source_ip.to_uint32();
+            }
+
+            for (size_t i = 0; i < n; ++i) {
+                const uint64_t bit = 1ULL << i;
+                if (UNLIKELY(whitelisted_ips_cache_.contains(src_ips[i]))) {
+                    whitelisted |= bit;
+                } else if (UNLIKELY(blocked_ips_cache_.contains(src_ips[i]))) {
+                    maybe_blocked |= bit;
                 }
-                
-                // Check if packet should be dropped
-                if (action == MitigationAction::DROP_PACKET || 
-                    action == MitigationAction::BLOCK_IP) {
-                    should_drop = true;
+            }
+
+            // PASS 1.5: SIMD pre-classification of Modbus headers. Packets
+            // that fail the vectorized MBAP plausibility test skip the full
+            // parse attempt and go straight to the analyzer as malformed.
+            uint64_t modbus_malformed = 0;
+            {
+                std::array<const std::byte*, MAX_BATCH_SIZE> ptrs;
+                std::array<size_t, MAX_BATCH_SIZE> lens;
+                std::array<uint8_t, MAX_BATCH_SIZE> orig_idx;
+                size_t n_modbus = 0;
+
+                const uint64_t preclassified = whitelisted | maybe_blocked;
+                for (size_t i = 0; i < n; ++i) {
+                    if (preclassified & (1ULL << i)) continue;
+                    if (batch[i].dest_port != 502 && batch[i].source_port != 502) continue;
+                    ptrs[n_modbus] = batch[i].data.data();
+                    lens[n_modbus] = batch[i].data.size();
+                    orig_idx[n_modbus] = static_cast<uint8_t>(i);
+                    ++n_modbus;
+                }
+
+                if (n_modbus > 0) {
+                    uint64_t plausible = preclassifyModbusBatch(
+                        ptrs.data(), lens.data(), n_modbus);
+                    for (size_t j = 0; j < n_modbus; ++j) {
+                        if (!((plausible >> j) & 1)) {
+                            modbus_malformed |= 1ULL << orig_idx[j];
+                        }
+                    }
                 }
             }
-            
-            // Update final statistics
-            if (should_drop) {
-                stats_.incrementPacketsDropped();
-            } else {
-                stats_.incrementPacketsAllowed();
-                metrics_.throughput().record(packet_data.size());
+
+            // PASS 2: resolve verdicts (analyzer only sees unclassified packets)
+            uint64_t verdicts = 0;
+
+            for (size_t i = 0; i < n; ++i) {
+                const uint64_t bit = 1ULL << i;
+                const PacketView& pkt = batch[i];
+
+                stats_.incrementPacketsProcessed();
+
+                if (whitelisted & bit) {
+                    stats_.incrementPacketsAllowed();
+                    metrics_.throughput().record(pkt.data.size());
+                    verdicts |= bit;
+                    continue;
+                }
+
+                if (maybe_blocked & bit) {
+                    // Double-check with mitigation engine (bloom false positives)
+                    if (mitigation_.isBlocked(pkt.source_ip)) {
+                        stats_.incrementPacketsDropped();
+                        continue;
+                    }
+                }
+
+                // CIDR blocks bypass the /32 bloom cache entirely
+                if (UNLIKELY(mitigation_.hasSubnetBlocks()) &&
+                    mitigation_.isSubnetBlocked(pkt.source_ip)) {
+                    stats_.incrementPacketsDropped();
+                    continue;
+                }
+
+                // Slow path without per-packet clock reads
+                if (runDetectionPath(pkt.data, pkt.source_ip, pkt.dest_ip,
+                                     pkt.source_port, pkt.dest_port,
+                                     src_ips[i], /*sample_threat_latency=*/false,
+                                     /*known_malformed=*/(modbus_malformed & bit) != 0,
+                                     stage_profiler_.shouldSample())) {
+                    verdicts |= bit;
+                }
             }
-            
-            recordLatency(start);
-            return !should_drop; // ALLOW if not dropped
+
+            // Record amortized per-packet latency once per batch
+            auto total = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start
+            );
+            metrics_.packetProcessingLatency().record(total / n);
+
+            return verdicts;
         }
-        
+
         // ====================================================================
         // Statistics & Management
         // ====================================================================
@@ -212,42 +351,193 @@ namespace gw::scada {
                 capture::LatencyTracker::Stats threat_latency;
                 capture::ThroughputTracker::Stats throughput;
                 double memory_usage_mb;
+                bool stage_profiling;
+                perf::StageSnapshot stage_profile;
             };
-            
+
             Metrics m;
             m.packet_latency = metrics_.packetProcessingLatency().getStats();
             m.threat_latency = metrics_.threatDetectionLatency().getStats();
             m.throughput = metrics_.throughput().getStats();
             m.memory_usage_mb = metrics_.resources().getMemoryUsageMB();
+            m.stage_profiling = perf::StageProfiler::ENABLED;
+            m.stage_profile = stage_profiler_.snapshot();
             return m;
         }
+
+        // Runtime sampling knob for the stage profiler: 1 = every packet,
+        // N = every Nth per worker thread. No-op in builds without
+        // GW_PROFILE_STAGES.
+        void setProfileSampleInterval(uint32_t n) noexcept {
+            stage_profiler_.setSampleInterval(n);
+        }
+
+        // Raw tracker access (Prometheus exporter walks the histogram)
+        [[nodiscard]] const capture::MetricsManager& getMetricsManager() const noexcept {
+            return metrics_;
+        }
+
+        // Copy of the current snapshot (control-plane use; the hot path
+        // holds the shared_ptr instead of copying)
+        [[nodiscard]] DetectionConfig getConfig() const {
+            return *config_.snapshot();
+        }
+
+        // ====================================================================
+        // Hot reload (RCU swap - workers never stall)
+        // ====================================================================
+        // Publishes a new config snapshot: thresholds take effect on the
+        // next per-packet snapshot load, whitelist deltas propagate to the
+        // mitigation engine and the counting bloom cache. Structural knobs
+        // (journal paths, critical register ranges, thread counts) are
+        // pinned at construction and carried over unchanged. Returns false
+        // without publishing if the new config fails validation.
+        bool reloadConfig(const DetectionConfig& next) {
+            if (!next.isValid()) return false;
+
+            auto old = config_.snapshot();
+
+            DetectionConfig applied = next;
+            applied.blocklist_journal_path = old->blocklist_journal_path;
+            applied.alert_journal_path = old->alert_journal_path;
+            applied.critical_registers = old->critical_registers;
+            applied.worker_threads = old->worker_threads;
+            applied.log_queue_size = old->log_queue_size;
+
+            // Whitelist deltas: keep engine truth and the bloom cache in
+            // lockstep (the counting filter supports the removals)
+            auto contains_ip = [](const std::vector<net::ipv4>& v,
+                                  const net::ipv4& ip) {
+                for (const auto& e : v) {
+                    if (e.to_uint32() == ip.to_uint32()) return true;
+                }
+                return false;
+            };
+            for (const auto& ip : old->whitelisted_ips) {
+                if (!contains_ip(applied.whitelisted_ips, ip)) {
+                    mitigation_.removeWhitelist(ip);
+                    whitelisted_ips_cache_.remove(ip.to_uint32());
+                }
+            }
+            for (const auto& ip : applied.whitelisted_ips) {
+                if (!contains_ip(old->whitelisted_ips, ip)) {
+                    mitigation_.addWhitelist(ip);
+                    whitelisted_ips_cache_.add(ip.to_uint32());
+                }
+            }
+
+            auto contains_cidr = [](const std::vector<DetectionConfig::Cidr>& v,
+                                    const DetectionConfig::Cidr& c) {
+                for (const auto& e : v) {
+                    if (e.address.to_uint32() == c.address.to_uint32() &&
+                        e.prefix_length == c.prefix_length) return true;
+                }
+                return false;
+            };
+            for (const auto& cidr : old->whitelisted_subnets) {
+                if (!contains_cidr(applied.whitelisted_subnets, cidr)) {
+                    mitigation_.removeWhitelistSubnet(cidr.address,
+                                                      cidr.prefix_length);
+                }
+            }
+            for (const auto& cidr : applied.whitelisted_subnets) {
+                if (!contains_cidr(old->whitelisted_subnets, cidr)) {
+                    mitigation_.addWhitelistSubnet(cidr.address,
+                                                   cidr.prefix_length);
+                }
+            }
+
+            // Retune the rate limiter, then publish: a worker sees either
+            // the old snapshot with the old limits or the new pair - both
+            // self-consistent within one packet
+            mitigation_.applyConfig(applied);
+            config_.publish(applied);
+
+            auto entry = capture::LogEntry::make(
+                capture::LogEntry::Level::INFO,
+                capture::LogSource::GRID_WATCHER,
+                capture::LogMessage::CONFIG_RELOADED);
+            entry.counts[0] = applied.dos_packet_threshold;
+            entry.counts[1] = applied.port_scan_threshold;
+            logger_->log(entry);
+
+            return true;
+        }
         
         [[nodiscard]] std::vector<BlockedIP> getBlockedIPs() const {
             return mitigation_.getBlockedIPs();
         }
-        
+
+        // Exact block-state probe (host entry or covering CIDR rule). Used
+        // by enforcement frontends to decide drop-frame vs reset-session.
+        [[nodiscard]] bool isIPBlocked(const net::ipv4& ip) const noexcept {
+            return mitigation_.isBlocked(ip);
+        }
+
         // Manual IP management
         void blockIP(const net::ipv4& ip, AttackType reason = AttackType::NONE) {
-            mitigation_.blockIP(ip, reason, config_.auto_block_duration);
-            blocked_ips_cache_.add(ip.to_uint32());
-            logger_->warning("ManualControl", "IP manually blocked: " + ip.toString());
+            // Only a fresh block feeds the counting bloom cache: removal
+            // fires once per entry, so counting an extend here would leak
+            // the 4-bit counters toward sticky saturation
+            if (mitigation_.blockIP(ip, reason,
+                                    config_.snapshot()->auto_block_duration)) {
+                blocked_ips_cache_.add(ip.to_uint32());
+            }
+            logger_->warning(capture::LogSource::MANUAL_CONTROL,
+                             capture::LogMessage::IP_BLOCKED_MANUAL, ip);
         }
         
         void unblockIP(const net::ipv4& ip) {
             if (mitigation_.unblockIP(ip)) {
-                logger_->info("ManualControl", "IP manually unblocked: " + ip.toString());
+                blocked_ips_cache_.remove(ip.to_uint32());
+                logger_->info(capture::LogSource::MANUAL_CONTROL,
+                              capture::LogMessage::IP_UNBLOCKED_MANUAL, ip);
             }
         }
-        
+
+        // Manual subnet management (CIDR; bypasses the /32 bloom cache)
+        void blockSubnet(const net::ipv4& prefix, uint8_t prefix_length,
+                         AttackType reason = AttackType::NONE) {
+            if (mitigation_.blockSubnet(prefix, prefix_length, reason)) {
+                auto entry = capture::LogEntry::make(
+                    capture::LogEntry::Level::WARNING,
+                    capture::LogSource::MANUAL_CONTROL,
+                    capture::LogMessage::SUBNET_BLOCKED_MANUAL);
+                entry.arg_ip = prefix.to_uint32();
+                entry.counts[0] = prefix_length;
+                logger_->log(entry);
+            }
+        }
+
+        void unblockSubnet(const net::ipv4& prefix, uint8_t prefix_length) {
+            if (mitigation_.unblockSubnet(prefix, prefix_length)) {
+                auto entry = capture::LogEntry::make(
+                    capture::LogEntry::Level::INFO,
+                    capture::LogSource::MANUAL_CONTROL,
+                    capture::LogMessage::SUBNET_UNBLOCKED_MANUAL);
+                entry.arg_ip = prefix.to_uint32();
+                entry.counts[0] = prefix_length;
+                logger_->log(entry);
+            }
+        }
+
+        [[nodiscard]] std::vector<scada::BlockedSubnet>
+        getBlockedSubnets() const {
+            return mitigation_.getBlockedSubnets();
+        }
+
         void addWhitelist(const net::ipv4& ip) {
             mitigation_.addWhitelist(ip);
             whitelisted_ips_cache_.add(ip.to_uint32());
-            logger_->info("ManualControl", "IP added to whitelist: " + ip.toString());
+            logger_->info(capture::LogSource::MANUAL_CONTROL,
+                          capture::LogMessage::IP_WHITELISTED, ip);
         }
         
         void removeWhitelist(const net::ipv4& ip) {
             mitigation_.removeWhitelist(ip);
-            logger_->info("ManualControl", "IP removed from whitelist: " + ip.toString());
+            whitelisted_ips_cache_.remove(ip.to_uint32());
+            logger_->info(capture::LogSource::MANUAL_CONTROL,
+                          capture::LogMessage::IP_UNWHITELISTED, ip);
         }
         
         // Logger access
@@ -257,13 +547,114 @@ namespace gw::scada {
         // ====================================================================
         // Helper Methods
         // ====================================================================
-        
+
+        // Shared slow path: parse + rate limit + behavioral analysis + threats.
+        // The batch API disables per-packet threat latency sampling so the
+        // only clock reads are the amortized ones at the batch boundaries.
+        bool runDetectionPath(
+            std::span<const std::byte> packet_data,
+            const net::ipv4& source_ip,
+            const net::ipv4& dest_ip,
+            uint16_t source_port,
+            uint16_t dest_port,
+            uint32_t src_ip_int,
+            bool sample_threat_latency,
+            bool known_malformed = false,
+            bool profile = false) noexcept
+        {
+            // One RCU snapshot load covers every threshold this packet
+            // consults; a concurrent reload takes effect on the next packet
+            const auto cfg = config_.snapshot();
+
+            // Parse packet metadata (minimal parsing for speed)
+            perf::StageTimer parse_timer(
+                stage_profiler_, perf::Stage::PARSE, profile);
+            PacketMetadata meta = buildPacketMetadata(
+                packet_data, source_ip, dest_ip, source_port, dest_port,
+                known_malformed
+            );
+            parse_timer.finish();
+
+            // Check if should drop before analysis (rate limiting)
+            {
+                perf::StageTimer rate_timer(
+                    stage_profiler_, perf::Stage::RATE_LIMIT, profile);
+                if (mitigation_.shouldDropPacket(meta)) {
+                    stats_.incrementPacketsDropped();
+                    return false; // DROP
+                }
+            }
+
+            // Behavioral analysis (detect threats)
+            std::chrono::steady_clock::time_point threat_start;
+            if (sample_threat_latency) {
+                threat_start = std::chrono::steady_clock::now();
+            }
+            BehavioralAnalyzer::AlertBuffer threats;
+            {
+                perf::StageTimer analyze_timer(
+                    stage_profiler_, perf::Stage::ANALYZE, profile);
+                analyzer_.analyze(meta, threats, *cfg);
+            }
+            if (sample_threat_latency) {
+                metrics_.threatDetectionLatency().record(
+                    std::chrono::steady_clock::now() - threat_start
+                );
+            }
+
+            // Process threats
+            perf::StageTimer mitigate_timer(
+                stage_profiler_, perf::Stage::MITIGATE, profile);
+            bool should_drop = false;
+            for (const auto& threat : threats) {
+                stats_.incrementThreatsDetected();
+
+                // Log threat (POD record - no allocation even mid-storm)
+                logger_->critical(capture::LogSource::THREAT_DETECTOR,
+                                  capture::LogMessage::THREAT_DETECTED, threat);
+
+                // Forensic copy into the binary journal: one slot claim +
+                // one record write, immune to logger ring pressure
+                alert_journal_.append(threat);
+
+                // Trigger mitigation
+                auto outcome = mitigation_.mitigate(threat, *cfg);
+
+                // Update bloom filter cache only on the fresh-block
+                // transition: the analyzer can raise several threats per
+                // packet and each repeat BLOCK_IP merely extends the same
+                // table entry, whose cache bits are already set (and whose
+                // removal will decrement them exactly once)
+                if (outcome.fresh_block) {
+                    blocked_ips_cache_.add(src_ip_int);
+                }
+
+                // Check if packet should be dropped
+                if (outcome.action == MitigationAction::DROP_PACKET ||
+                    outcome.action == MitigationAction::BLOCK_IP) {
+                    should_drop = true;
+                }
+            }
+            mitigate_timer.finish();
+
+            // Update final statistics
+            if (should_drop) {
+                stats_.incrementPacketsDropped();
+            } else {
+                stats_.incrementPacketsAllowed();
+                metrics_.throughput().record(packet_data.size());
+            }
+
+            return !should_drop; // ALLOW if not dropped
+        }
+
         PacketMetadata buildPacketMetadata(
             std::span<const std::byte> packet_data,
             const net::ipv4& source_ip,
             const net::ipv4& dest_ip,
             uint16_t source_port,
-            uint16_t dest_port) noexcept 
+            uint16_t dest_port,
+            bool known_malformed = false) noexcept
         {
             PacketMetadata meta;
             meta.source_ip = source_ip;
@@ -271,13 +662,21 @@ namespace gw::scada {
             meta.source_port = source_port;
             meta.dest_port = dest_port;
             meta.packet_size = packet_data.size();
-            meta.timestamp = std::chrono::system_clock::now();
-            
-            // Protocol detection and parsing
-            if (dest_port == 502 || source_port == 502) {
-                // Modbus TCP
-                if (isModbusTCP(packet_data)) {
-                    auto parsed = ModbusParser::parse(packet_data);
+            meta.timestamp = perf::CoarseClock::systemNow();
+
+            // Protocol detection and parsing: one table lookup picks the
+            // parser (Modbus/DNP3/IEC-104) - adding a protocol is a new
+            // ProtocolTraits specialization, not another branch here
+            const ProtocolHandler& handler =
+                protocolHandlerFor(source_port, dest_port);
+
+            if (handler.protocol != ProtocolType::UNKNOWN) {
+                if (known_malformed) {
+                    // Batch pre-classifier already rejected this header -
+                    // skip the parse attempt entirely
+                    meta.is_malformed = true;
+                } else if (handler.preview(packet_data)) {
+                    auto parsed = handler.parse(packet_data);
                     if (parsed) {
                         meta = *parsed;
                         meta.source_ip = source_ip;
@@ -290,10 +689,9 @@ namespace gw::scada {
                 } else {
                     meta.is_malformed = true;
                 }
-                meta.protocol = ProtocolType::MODBUS_TCP;
+                meta.protocol = handler.protocol;
             }
-            // Add more protocol parsers here (DNP3, IEC-104, etc.)
-            
+
             return meta;
         }
         
@@ -304,15 +702,16 @@ namespace gw::scada {
         }
         
         void handleMitigationAction(const ThreatAlert& alert, MitigationAction action) {
-            std::ostringstream msg;
-            msg << "Mitigation: " << to_string(action)
-                << " for " << alert.source_ip.toString()
-                << " due to " << to_string(alert.attack_type);
-            
             if (action == MitigationAction::BLOCK_IP) {
-                logger_->warning("Mitigation", msg.str());
+                logger_->warning(capture::LogSource::MITIGATION,
+                                 capture::LogMessage::MITIGATION_BLOCK, alert);
             } else {
-                logger_->info("Mitigation", msg.str());
+                auto entry = capture::LogEntry::make(
+                    capture::LogEntry::Level::INFO,
+                    capture::LogSource::MITIGATION,
+                    capture::LogMessage::MITIGATION_APPLIED);
+                entry.setThreat(alert);
+                logger_->log(entry);
             }
         }
         
@@ -326,10 +725,21 @@ namespace gw::scada {
                 
                 if (!running_.load(std::memory_order_relaxed)) break;
                 
-                // Cleanup expired blocks
-                mitigation_.cleanup();
-                
-                logger_->info("Cleanup", "Periodic cleanup completed");
+                // Cleanup expired blocks, purging each reclaimed IP from the
+                // fast-path cache as it expires
+                mitigation_.cleanup([this](uint32_t ip_key) {
+                    blocked_ips_cache_.remove(ip_key);
+                });
+
+                // Age out idle IPs so churn can't exhaust the analyzer tables
+                size_t evicted = analyzer_.evictStale();
+
+                auto entry = capture::LogEntry::make(
+                    capture::LogEntry::Level::INFO,
+                    capture::LogSource::CLEANUP,
+                    capture::LogMessage::CLEANUP_COMPLETED);
+                entry.counts[0] = evicted;
+                logger_->log(entry);
             }
         }
         
@@ -338,21 +748,25 @@ namespace gw::scada {
                 std::this_thread::sleep_for(std::chrono::seconds(30));
                 
                 if (!running_.load(std::memory_order_relaxed)) break;
-                
+
                 auto stats = getStatistics();
                 auto metrics = getMetrics();
                 
-                std::ostringstream msg;
-                msg << "Stats: "
-                    << stats.packets_processed << " pkts ("
-                    << std::fixed << std::setprecision(1) << stats.packets_per_second << " pps) | "
-                    << stats.threats_detected << " threats ("
-                    << std::fixed << std::setprecision(2) << stats.threat_rate_per_minute << "/min) | "
-                    << "Latency: " << std::fixed << std::setprecision(2) 
-                    << metrics.packet_latency.avg_us << " μs | "
-                    << stats.active_blocks << " active blocks";
-                
-                logger_->info("Monitor", msg.str());
+                auto entry = capture::LogEntry::make(
+                    capture::LogEntry::Level::INFO,
+                    capture::LogSource::MONITOR,
+                    capture::LogMessage::MONITOR_STATS);
+                entry.counts[0] = stats.packets_processed;
+                entry.counts[1] = stats.threats_detected;
+                entry.counts[2] = stats.active_blocks;
+                entry.values[0] = stats.packets_per_second;
+                entry.values[1] = stats.threat_rate_per_minute;
+                entry.values[2] = metrics.packet_latency.avg_us;
+                logger_->log(entry);
+
+                // Alert journal durability: one msync per monitor interval,
+                // never from the packet path
+                alert_journal_.flush();
             }
         }
     };
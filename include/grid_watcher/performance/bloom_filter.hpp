@@ -60,4 +60,102 @@ public:
     }
 };
 
+// Deletable variant: 4-bit saturating counters instead of single bits.
+// Same cache-resident footprint class as BloomFilter (8192 counters = 4KB)
+// but supports remove(), so expired or manually lifted blocks actually
+// leave the cache instead of poisoning the fast path forever. A counter
+// that saturates at 15 becomes sticky (never decremented) - the classic
+// counting-bloom tradeoff, vanishingly rare at our occupancy.
+template<size_t NumCounters = 8192, size_t NumHashes = 3>
+class CountingBloomFilter {
+private:
+    static constexpr size_t COUNTERS_PER_WORD = 16; // 4 bits each
+    static constexpr size_t NUM_WORDS = NumCounters / COUNTERS_PER_WORD;
+    static constexpr uint64_t COUNTER_MAX = 0xF;
+
+    std::array<std::atomic<uint64_t>, NUM_WORDS> words_;
+
+    static constexpr uint32_t hash1(uint32_t x) noexcept {
+        return (x * 2654435761u) % NumCounters;
+    }
+
+    static constexpr uint32_t hash2(uint32_t x) noexcept {
+        return (x * 2246822519u) % NumCounters;
+    }
+
+    static constexpr uint32_t hash3(uint32_t x) noexcept {
+        return (x * 3266489917u) % NumCounters;
+    }
+
+    void increment(size_t idx) noexcept {
+        size_t word = idx / COUNTERS_PER_WORD;
+        size_t shift = (idx % COUNTERS_PER_WORD) * 4;
+
+        uint64_t current = words_[word].load(std::memory_order_relaxed);
+        for (;;) {
+            uint64_t counter = (current >> shift) & COUNTER_MAX;
+            if (counter == COUNTER_MAX) return; // saturated - stays sticky
+
+            if (words_[word].compare_exchange_weak(
+                    current, current + (1ULL << shift),
+                    std::memory_order_relaxed)) {
+                return;
+            }
+        }
+    }
+
+    void decrement(size_t idx) noexcept {
+        size_t word = idx / COUNTERS_PER_WORD;
+        size_t shift = (idx % COUNTERS_PER_WORD) * 4;
+
+        uint64_t current = words_[word].load(std::memory_order_relaxed);
+        for (;;) {
+            uint64_t counter = (current >> shift) & COUNTER_MAX;
+            if (counter == 0 || counter == COUNTER_MAX) return; // empty/sticky
+
+            if (words_[word].compare_exchange_weak(
+                    current, current - (1ULL << shift),
+                    std::memory_order_relaxed)) {
+                return;
+            }
+        }
+    }
+
+    bool test(size_t idx) const noexcept {
+        size_t word = idx / COUNTERS_PER_WORD;
+        size_t shift = (idx % COUNTERS_PER_WORD) * 4;
+        return ((words_[word].load(std::memory_order_relaxed) >> shift)
+                & COUNTER_MAX) != 0;
+    }
+
+public:
+    CountingBloomFilter() {
+        clear();
+    }
+
+    void add(uint32_t value) noexcept {
+        increment(hash1(value));
+        increment(hash2(value));
+        increment(hash3(value));
+    }
+
+    void remove(uint32_t value) noexcept {
+        decrement(hash1(value));
+        decrement(hash2(value));
+        decrement(hash3(value));
+    }
+
+    bool contains(uint32_t value) const noexcept {
+        return test(hash1(value)) &&
+               test(hash2(value)) &&
+               test(hash3(value));
+    }
+
+    void clear() noexcept {
+        for (auto& word : words_) {
+            word.store(0, std::memory_order_relaxed);
+        }
+    }
+};
+
 } // namespace gw::perf
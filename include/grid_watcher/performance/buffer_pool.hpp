@@ -0,0 +1,191 @@
+#pragma once
+#include "lock_free.hpp"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace gw::perf {
+
+// Fixed-size slab pool for packet payloads.
+//
+// Modbus TCP frames are at most 260 bytes, so one size class covers the
+// whole capture path: acquire() hands out a slab from a lock-free free
+// list and release() pushes it back, so steady-state packet submission
+// performs zero heap allocations (the old per-packet std::vector meant a
+// malloc/free per packet and allocator-lock contention under
+// multi-threaded submit).
+//
+// The free list is a Treiber stack over slab indices with a 32-bit ABA
+// tag packed into the head word - both acquire and release are a single
+// CAS. When the pool is drained (or a frame exceeds the slab size) the
+// handle falls back to a heap buffer, so overload degrades to the old
+// behaviour instead of dropping packets.
+class PacketBufferPool {
+public:
+    static constexpr size_t BUFFER_SIZE = 260;   // ModbusParser::MAX_PACKET_SIZE
+    static constexpr size_t POOL_SIZE = 65536;
+    static constexpr uint32_t NIL = UINT32_MAX;
+
+private:
+    struct Node {
+        std::array<std::byte, BUFFER_SIZE> data;
+        std::atomic<uint32_t> next_free{NIL};
+    };
+
+    // ~17MB: allocated once at startup, never touched by malloc again
+    std::unique_ptr<Node[]> nodes_;
+
+    // {tag:32 | index:32} - the tag increments on every pop so a stale
+    // head CAS cannot succeed after the node was recycled (ABA)
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> head_;
+
+    static constexpr uint64_t pack(uint32_t tag, uint32_t index) noexcept {
+        return (static_cast<uint64_t>(tag) << 32) | index;
+    }
+
+public:
+    PacketBufferPool()
+        : nodes_(std::make_unique<Node[]>(POOL_SIZE))
+    {
+        for (uint32_t i = 0; i + 1 < POOL_SIZE; ++i) {
+            nodes_[i].next_free.store(i + 1, std::memory_order_relaxed);
+        }
+        nodes_[POOL_SIZE - 1].next_free.store(NIL, std::memory_order_relaxed);
+        head_.store(pack(0, 0), std::memory_order_relaxed);
+    }
+
+    // Non-copyable
+    PacketBufferPool(const PacketBufferPool&) = delete;
+    PacketBufferPool& operator=(const PacketBufferPool&) = delete;
+
+    // Pop a slab index, or NIL when the pool is drained
+    uint32_t tryAcquire() noexcept {
+        uint64_t head = head_.load(std::memory_order_acquire);
+
+        for (;;) {
+            uint32_t index = static_cast<uint32_t>(head);
+            if (index == NIL) return NIL;
+
+            uint32_t next = nodes_[index].next_free.load(std::memory_order_relaxed);
+            uint64_t desired = pack(static_cast<uint32_t>(head >> 32) + 1, next);
+
+            if (head_.compare_exchange_weak(head, desired,
+                    std::memory_order_acq_rel)) {
+                return index;
+            }
+        }
+    }
+
+    void release(uint32_t index) noexcept {
+        uint64_t head = head_.load(std::memory_order_relaxed);
+
+        for (;;) {
+            nodes_[index].next_free.store(static_cast<uint32_t>(head),
+                                          std::memory_order_relaxed);
+            uint64_t desired = pack(static_cast<uint32_t>(head >> 32) + 1, index);
+
+            if (head_.compare_exchange_weak(head, desired,
+                    std::memory_order_release)) {
+                return;
+            }
+        }
+    }
+
+    std::byte* slab(uint32_t index) noexcept {
+        return nodes_[index].data.data();
+    }
+
+    const std::byte* slab(uint32_t index) const noexcept {
+        return nodes_[index].data.data();
+    }
+};
+
+// Movable RAII handle to a pooled payload buffer. Returns the slab to the
+// pool when destroyed or overwritten, so the worker finishing a PacketJob
+// automatically recycles its buffer.
+class PooledBuffer {
+private:
+    PacketBufferPool* pool_{nullptr};
+    uint32_t index_{PacketBufferPool::NIL};
+    uint32_t size_{0};
+    std::vector<std::byte> overflow_; // heap fallback (pool drained/oversize)
+
+    void releaseSlab() noexcept {
+        if (pool_ && index_ != PacketBufferPool::NIL) {
+            pool_->release(index_);
+        }
+        pool_ = nullptr;
+        index_ = PacketBufferPool::NIL;
+        size_ = 0;
+    }
+
+public:
+    PooledBuffer() = default;
+
+    // Copy the payload into a pool slab (or the heap fallback)
+    PooledBuffer(PacketBufferPool& pool, std::span<const std::byte> payload) {
+        if (payload.size() <= PacketBufferPool::BUFFER_SIZE) {
+            uint32_t index = pool.tryAcquire();
+            if (LIKELY(index != PacketBufferPool::NIL)) {
+                std::memcpy(pool.slab(index), payload.data(), payload.size());
+                pool_ = &pool;
+                index_ = index;
+                size_ = static_cast<uint32_t>(payload.size());
+                return;
+            }
+        }
+        overflow_.assign(payload.begin(), payload.end());
+    }
+
+    ~PooledBuffer() {
+        releaseSlab();
+    }
+
+    // Move-only: exactly one owner returns the slab
+    PooledBuffer(const PooledBuffer&) = delete;
+    PooledBuffer& operator=(const PooledBuffer&) = delete;
+
+    PooledBuffer(PooledBuffer&& other) noexcept
+        : pool_(other.pool_)
+        , index_(other.index_)
+        , size_(other.size_)
+        , overflow_(std::move(other.overflow_))
+    {
+        other.pool_ = nullptr;
+        other.index_ = PacketBufferPool::NIL;
+        other.size_ = 0;
+    }
+
+    PooledBuffer& operator=(PooledBuffer&& other) noexcept {
+        if (this != &other) {
+            releaseSlab();
+            overflow_ = std::move(other.overflow_);
+            pool_ = other.pool_;
+            index_ = other.index_;
+            size_ = other.size_;
+            other.pool_ = nullptr;
+            other.index_ = PacketBufferPool::NIL;
+            other.size_ = 0;
+        }
+        return *this;
+    }
+
+    std::span<const std::byte> view() const noexcept {
+        if (index_ != PacketBufferPool::NIL) {
+            return {pool_->slab(index_), size_};
+        }
+        return {overflow_.data(), overflow_.size()};
+    }
+
+    size_t size() const noexcept {
+        return (index_ != PacketBufferPool::NIL) ? size_ : overflow_.size();
+    }
+
+    bool empty() const noexcept { return size() == 0; }
+};
+
+} // namespace gw::perf
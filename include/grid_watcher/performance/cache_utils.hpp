@@ -1,5 +1,13 @@
 #pragma once
 #include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#ifndef CACHE_LINE_SIZE
+#define CACHE_LINE_SIZE 64
+#endif
 
 namespace gw::perf {
 
@@ -17,4 +25,73 @@ constexpr size_t cache_aligned_size() noexcept {
     return ((sizeof(T) + cache_line - 1) / cache_line) * cache_line;
 }
 
+// ============================================================================
+// Coarse shared clock
+// ============================================================================
+// Per-packet timestamping used to pay a vDSO clock read (~25ns on the
+// Atom-class sensors) at every site that wanted "roughly now" - metadata
+// stamps, rate windows, throughput buckets - adding up to >100ns of pure
+// clock overhead per packet. This clock is advanced by one background
+// ticker (~0.2ms period) into cache-line-aligned atomics; readers pay a
+// single relaxed load. Use it wherever sub-millisecond precision is not
+// needed; latency measurements keep their precise clock reads.
+class CoarseClock {
+private:
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> steady_ns_;
+    std::atomic<uint64_t> system_ns_;
+    std::atomic<bool> running_{true};
+    std::thread ticker_;
+
+    static constexpr auto TICK_PERIOD = std::chrono::microseconds(200);
+
+    CoarseClock() {
+        refresh();
+        ticker_ = std::thread([this] {
+            while (running_.load(std::memory_order_relaxed)) {
+                refresh();
+                std::this_thread::sleep_for(TICK_PERIOD);
+            }
+        });
+    }
+
+    ~CoarseClock() {
+        running_.store(false, std::memory_order_relaxed);
+        if (ticker_.joinable()) ticker_.join();
+    }
+
+    void refresh() noexcept {
+        steady_ns_.store(static_cast<uint64_t>(
+            std::chrono::steady_clock::now().time_since_epoch().count()),
+            std::memory_order_relaxed);
+        system_ns_.store(static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count()),
+            std::memory_order_relaxed);
+    }
+
+    static CoarseClock& instance() noexcept {
+        static CoarseClock clock;
+        return clock;
+    }
+
+public:
+    CoarseClock(const CoarseClock&) = delete;
+    CoarseClock& operator=(const CoarseClock&) = delete;
+
+    // HOT PATH: one relaxed load each
+    static uint64_t steadyNs() noexcept {
+        return instance().steady_ns_.load(std::memory_order_relaxed);
+    }
+
+    static uint64_t systemNs() noexcept {
+        return instance().system_ns_.load(std::memory_order_relaxed);
+    }
+
+    static std::chrono::system_clock::time_point systemNow() noexcept {
+        return std::chrono::system_clock::time_point(
+            std::chrono::duration_cast<std::chrono::system_clock::duration>(
+                std::chrono::nanoseconds(systemNs())));
+    }
+};
+
 } // namespace gw::perf
@@ -1,4 +1,5 @@
 #pragma once
+#include "huge_pages.hpp"
 #include <array>
 #include <cstdint>
 #include <optional>
@@ -6,29 +7,50 @@
 
 namespace gw::perf {
 
-// Fast hash map with open addressing (fixed size, no allocation)
+// Fast hash map with open addressing (fixed size, no allocation).
+//
+// Supports tombstone-aware deletion and CLOCK-style generational aging so
+// long-running trackers survive IP churn: every find/emplace stamps the
+// entry with the current generation, and a periodic sweep() evicts entries
+// that have not been touched for a few generations. Without this, a
+// spoofed-source flood fills the table once and blinds the caller forever.
+//
+// Concurrency note: the table structure itself is not synchronized (same
+// as the original design). Callers that probe from multiple threads while
+// a background thread sweeps must use values whose updates are atomic and
+// whose destruction is trivial (e.g. the analyzer's stats structs).
 template<typename Value, size_t Capacity>
 class FastHashMap {
 private:
+    enum class SlotState : uint8_t {
+        EMPTY = 0,     // never used - terminates probe chains
+        OCCUPIED = 1,
+        TOMBSTONE = 2  // deleted - probes continue, emplace may reuse
+    };
+
     struct Entry {
         uint32_t key;
+        uint32_t last_touched_gen;
         alignas(alignof(Value)) std::byte value_storage[sizeof(Value)];
-        bool occupied;
-        
-        Entry() : key(0), occupied(false) {}
-        
+        SlotState state;
+
+        Entry() : key(0), last_touched_gen(0), state(SlotState::EMPTY) {}
+
         Value* value() noexcept {
             return reinterpret_cast<Value*>(value_storage);
         }
-        
+
         const Value* value() const noexcept {
             return reinterpret_cast<const Value*>(value_storage);
         }
     };
-    
-    std::array<Entry, Capacity> table_;
+
+    // Huge-page-backed: the big instantiations (megabytes of entries,
+    // probed at random per packet) stop paying a TLB miss per probe
+    HugeArray<Entry, Capacity> table_;
     size_t size_{0};
-    
+    uint32_t generation_{0};
+
     static constexpr uint32_t hash(uint32_t key) noexcept {
         // MurmurHash3 finalizer
         key ^= key >> 16;
@@ -38,71 +60,154 @@ private:
         key ^= key >> 16;
         return key % Capacity;
     }
-    
+
 public:
     FastHashMap() = default;
-    
+
     ~FastHashMap() {
         for (auto& entry : table_) {
-            if (entry.occupied) {
+            if (entry.state == SlotState::OCCUPIED) {
                 entry.value()->~Value();
             }
         }
     }
-    
+
     // Non-copyable due to placement new
     FastHashMap(const FastHashMap&) = delete;
     FastHashMap& operator=(const FastHashMap&) = delete;
-    
+
     Value* find(uint32_t key) noexcept {
         uint32_t idx = hash(key);
-        
+
         for (size_t probe = 0; probe < Capacity; ++probe) {
             auto& entry = table_[(idx + probe) % Capacity];
-            
-            if (!entry.occupied) {
+
+            if (entry.state == SlotState::EMPTY) {
                 return nullptr;
             }
-            
-            if (entry.key == key) {
+
+            if (entry.state == SlotState::OCCUPIED && entry.key == key) {
+                entry.last_touched_gen = generation_;
                 return entry.value();
             }
+            // TOMBSTONE (or key mismatch): keep probing
         }
-        
+
         return nullptr;
     }
-    
+
     const Value* find(uint32_t key) const noexcept {
         return const_cast<FastHashMap*>(this)->find(key);
     }
-    
+
     template<typename... Args>
     Value* emplace(uint32_t key, Args&&... args) noexcept {
         if (size_ >= Capacity * 0.75) {
             return nullptr; // Too full (maintain performance)
         }
-        
+
         uint32_t idx = hash(key);
-        
+        Entry* reusable = nullptr; // first tombstone along the probe chain
+
         for (size_t probe = 0; probe < Capacity; ++probe) {
             auto& entry = table_[(idx + probe) % Capacity];
-            
-            if (!entry.occupied) {
-                entry.key = key;
-                new (entry.value_storage) Value(std::forward<Args>(args)...);
-                entry.occupied = true;
+
+            if (entry.state == SlotState::EMPTY) {
+                Entry& target = reusable ? *reusable : entry;
+                target.key = key;
+                new (target.value_storage) Value(std::forward<Args>(args)...);
+                target.last_touched_gen = generation_;
+                target.state = SlotState::OCCUPIED;
                 size_++;
-                return entry.value();
+                return target.value();
             }
-            
-            if (entry.key == key) {
+
+            if (entry.state == SlotState::OCCUPIED && entry.key == key) {
+                entry.last_touched_gen = generation_;
                 return entry.value(); // Already exists
             }
+
+            if (entry.state == SlotState::TOMBSTONE && !reusable) {
+                reusable = &entry;
+            }
+        }
+
+        // Probe wrapped without hitting EMPTY - fall back to a tombstone
+        if (reusable) {
+            reusable->key = key;
+            new (reusable->value_storage) Value(std::forward<Args>(args)...);
+            reusable->last_touched_gen = generation_;
+            reusable->state = SlotState::OCCUPIED;
+            size_++;
+            return reusable->value();
+        }
+
+        return nullptr;
+    }
+
+    // Tombstone-aware deletion: probe chains through the slot stay intact
+    bool erase(uint32_t key) noexcept {
+        uint32_t idx = hash(key);
+
+        for (size_t probe = 0; probe < Capacity; ++probe) {
+            auto& entry = table_[(idx + probe) % Capacity];
+
+            if (entry.state == SlotState::EMPTY) {
+                return false;
+            }
+
+            if (entry.state == SlotState::OCCUPIED && entry.key == key) {
+                entry.value()->~Value();
+                entry.state = SlotState::TOMBSTONE;
+                size_--;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    // CLOCK-style aging sweep: evicts entries untouched for more than
+    // max_idle_generations sweep periods, then advances the generation.
+    // Intended to be called from a periodic cleanup thread. Returns the
+    // number of evicted entries.
+    size_t sweep(uint32_t max_idle_generations = 1) noexcept {
+        size_t evicted = 0;
+
+        for (auto& entry : table_) {
+            if (entry.state != SlotState::OCCUPIED) continue;
+
+            if (generation_ - entry.last_touched_gen > max_idle_generations) {
+                entry.value()->~Value();
+                entry.state = SlotState::TOMBSTONE;
+                size_--;
+                evicted++;
+            }
         }
-        
-        return nullptr; // Should not happen if load factor check works
+
+        generation_++;
+        return evicted;
     }
-    
+
+    // Visit every live entry: fn(key, value)
+    template<typename Fn>
+    void forEach(Fn&& fn) noexcept {
+        for (auto& entry : table_) {
+            if (entry.state == SlotState::OCCUPIED) {
+                fn(entry.key, *entry.value());
+            }
+        }
+    }
+
+    template<typename Fn>
+    void forEach(Fn&& fn) const noexcept {
+        for (const auto& entry : table_) {
+            if (entry.state == SlotState::OCCUPIED) {
+                fn(entry.key, *entry.value());
+            }
+        }
+    }
+
     size_t size() const noexcept { return size_; }
     bool empty() const noexcept { return size_ == 0; }
 };
@@ -1,9 +1,12 @@
 #pragma once
 
 #include <atomic>
+#include <algorithm>
 #include <array>
 #include <cstddef>
 #include <optional>
+#include <span>
+#include <utility>
 
 // Compiler hints
 #ifdef __GNUC__
@@ -19,48 +22,148 @@
 namespace gw::perf {
 
 // Lock-free ring buffer (SPSC - Single Producer Single Consumer)
+//
+// Indices grow monotonically and are mapped to slots with `idx & MASK`,
+// so there is no modulo in the hot path and all Capacity slots are
+// usable (full = write - read == Capacity). Each side keeps a private
+// cached copy of the peer's index and only pays the acquire load when
+// the cached value suggests full/empty - while the ring is neither,
+// push and pop touch no shared cache line of the other side.
+//
+// The private index caches make each side single-threaded by contract:
+// callers that share a side across threads must serialize it externally
+// (the Logger's push_lock_, the batch processor's consuming flag).
 template<typename T, size_t Capacity>
 class alignas(CACHE_LINE_SIZE) LockFreeRingBuffer {
 private:
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0,
+                  "Capacity must be a power of two for mask indexing");
+    static constexpr size_t MASK = Capacity - 1;
+
     std::array<T, Capacity> buffer_;
     alignas(CACHE_LINE_SIZE) std::atomic<size_t> write_idx_{0};
+    size_t read_idx_cache_{0};   // producer-private, refreshed on apparent full
     alignas(CACHE_LINE_SIZE) std::atomic<size_t> read_idx_{0};
-    
+    size_t write_idx_cache_{0};  // consumer-private, refreshed on apparent empty
+
 public:
     bool push(const T& item) noexcept {
         size_t current_write = write_idx_.load(std::memory_order_relaxed);
-        size_t next_write = (current_write + 1) % Capacity;
-        
-        if (UNLIKELY(next_write == read_idx_.load(std::memory_order_acquire))) {
-            return false; // Full
+
+        if (UNLIKELY(current_write - read_idx_cache_ >= Capacity)) {
+            read_idx_cache_ = read_idx_.load(std::memory_order_acquire);
+            if (current_write - read_idx_cache_ >= Capacity) {
+                return false; // Full
+            }
         }
-        
-        buffer_[current_write] = item;
-        write_idx_.store(next_write, std::memory_order_release);
+
+        buffer_[current_write & MASK] = item;
+        write_idx_.store(current_write + 1, std::memory_order_release);
         return true;
     }
-    
+
+    // Move overload (for move-only payloads like pooled buffers)
+    bool push(T&& item) noexcept {
+        size_t current_write = write_idx_.load(std::memory_order_relaxed);
+
+        if (UNLIKELY(current_write - read_idx_cache_ >= Capacity)) {
+            read_idx_cache_ = read_idx_.load(std::memory_order_acquire);
+            if (current_write - read_idx_cache_ >= Capacity) {
+                return false; // Full
+            }
+        }
+
+        buffer_[current_write & MASK] = std::move(item);
+        write_idx_.store(current_write + 1, std::memory_order_release);
+        return true;
+    }
+
     bool pop(T& item) noexcept {
         size_t current_read = read_idx_.load(std::memory_order_relaxed);
-        
-        if (UNLIKELY(current_read == write_idx_.load(std::memory_order_acquire))) {
-            return false; // Empty
+
+        if (UNLIKELY(current_read == write_idx_cache_)) {
+            write_idx_cache_ = write_idx_.load(std::memory_order_acquire);
+            if (current_read == write_idx_cache_) {
+                return false; // Empty
+            }
         }
-        
-        item = buffer_[current_read];
-        read_idx_.store((current_read + 1) % Capacity, std::memory_order_release);
+
+        item = std::move(buffer_[current_read & MASK]);
+        read_idx_.store(current_read + 1, std::memory_order_release);
         return true;
     }
-    
+
+    // Copy as many items as fit, with ONE index update for the whole
+    // range. Returns the number actually enqueued (0..items.size()).
+    size_t push_bulk(std::span<const T> items) noexcept {
+        size_t current_write = write_idx_.load(std::memory_order_relaxed);
+        size_t free = Capacity - (current_write - read_idx_cache_);
+
+        if (UNLIKELY(items.size() > free)) {
+            read_idx_cache_ = read_idx_.load(std::memory_order_acquire);
+            free = Capacity - (current_write - read_idx_cache_);
+        }
+
+        size_t count = std::min(items.size(), free);
+        for (size_t i = 0; i < count; ++i) {
+            buffer_[(current_write + i) & MASK] = items[i];
+        }
+        if (count > 0) {
+            write_idx_.store(current_write + count, std::memory_order_release);
+        }
+        return count;
+    }
+
+    // Move overload: enqueued elements are moved-from in the caller's span
+    size_t push_bulk(std::span<T> items) noexcept {
+        size_t current_write = write_idx_.load(std::memory_order_relaxed);
+        size_t free = Capacity - (current_write - read_idx_cache_);
+
+        if (UNLIKELY(items.size() > free)) {
+            read_idx_cache_ = read_idx_.load(std::memory_order_acquire);
+            free = Capacity - (current_write - read_idx_cache_);
+        }
+
+        size_t count = std::min(items.size(), free);
+        for (size_t i = 0; i < count; ++i) {
+            buffer_[(current_write + i) & MASK] = std::move(items[i]);
+        }
+        if (count > 0) {
+            write_idx_.store(current_write + count, std::memory_order_release);
+        }
+        return count;
+    }
+
+    // Move out up to out.size() items with one index update. Returns the
+    // number actually dequeued (0..out.size()).
+    size_t pop_bulk(std::span<T> out) noexcept {
+        size_t current_read = read_idx_.load(std::memory_order_relaxed);
+        size_t available = write_idx_cache_ - current_read;
+
+        if (UNLIKELY(out.size() > available)) {
+            write_idx_cache_ = write_idx_.load(std::memory_order_acquire);
+            available = write_idx_cache_ - current_read;
+        }
+
+        size_t count = std::min(out.size(), available);
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = std::move(buffer_[(current_read + i) & MASK]);
+        }
+        if (count > 0) {
+            read_idx_.store(current_read + count, std::memory_order_release);
+        }
+        return count;
+    }
+
     bool empty() const noexcept {
-        return read_idx_.load(std::memory_order_acquire) == 
+        return read_idx_.load(std::memory_order_acquire) ==
                write_idx_.load(std::memory_order_acquire);
     }
-    
+
     size_t size() const noexcept {
         size_t write = write_idx_.load(std::memory_order_acquire);
         size_t read = read_idx_.load(std::memory_order_acquire);
-        return (write >= read) ? (write - read) : (Capacity - read + write);
+        return write - read; // indices are monotonic, difference never wraps
     }
 };
 
@@ -0,0 +1,226 @@
+#pragma once
+#include "lock_free.hpp"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace gw::perf {
+
+// Longest-prefix-match table for IPv4 CIDR rules (DIR-24-8 style, split
+// 16-8-8 to keep the root at 256KB instead of 32MB - we hold a few
+// thousand prefixes, not a BGP table).
+//
+// Readers are fully lock-free: a lookup is at most three dependent
+// indexed loads (root by the top 16 bits, then one chunk per deeper
+// 8-bit stride). Covering prefixes are pushed down into chunks at insert
+// time, so the walk never has to remember a "best so far".
+//
+// Writers (insert/remove) serialize on a mutex - CIDR rules are
+// control-plane events. Inserts are visible atomically per entry.
+// remove() rebuilds the structure from the rule list; during the
+// (microseconds-long) rebuild a concurrent lookup can transiently miss,
+// which is acceptable for block/whitelist rules and keeps readers free
+// of any synchronization.
+template<size_t MaxChunks = 2048>
+class LpmTable {
+private:
+    // Entry encoding:
+    //   bit 31 set -> pointer: bits 0..15 = chunk index
+    //   bit 30 set -> leaf with value: bits 8..15 = prefix length that
+    //                 wrote it (insert precedence), bits 0..7 = value
+    //   zero       -> no match
+    static constexpr uint32_t PTR = 0x80000000u;
+    static constexpr uint32_t SET = 0x40000000u;
+
+    static constexpr uint32_t leaf(uint8_t value, uint8_t plen) noexcept {
+        return SET | (static_cast<uint32_t>(plen) << 8) | value;
+    }
+    static constexpr uint8_t leafLen(uint32_t e) noexcept {
+        return static_cast<uint8_t>((e >> 8) & 0xFF);
+    }
+
+    using Chunk = std::array<std::atomic<uint32_t>, 256>;
+
+    std::unique_ptr<std::array<std::atomic<uint32_t>, 65536>> root_;
+    std::array<std::unique_ptr<Chunk>, MaxChunks> chunks_;
+    size_t chunks_used_{0};       // guarded by write_mutex_
+    size_t chunks_allocated_{0};  // high-water mark, chunks are recycled
+
+    struct Rule {
+        uint32_t prefix;
+        uint8_t len;
+        uint8_t value;
+    };
+    std::vector<Rule> rules_;            // guarded by write_mutex_
+    std::atomic<size_t> rule_count_{0};  // lock-free emptiness probe
+
+    mutable std::mutex write_mutex_;
+
+    Chunk* claimChunk() noexcept {
+        if (chunks_used_ >= MaxChunks) return nullptr;
+        if (chunks_used_ >= chunks_allocated_) {
+            chunks_[chunks_used_] = std::make_unique<Chunk>();
+            if (!chunks_[chunks_used_]) return nullptr;
+            ++chunks_allocated_;
+        }
+        return chunks_[chunks_used_++].get();
+    }
+
+    // Fill [first, last] of a table level with a leaf, respecting
+    // precedence: an existing leaf written by a longer prefix stays, a
+    // pointer entry recurses so the covering value lands in the chunk
+    template<typename Table>
+    void fillRange(Table& table, size_t first, size_t last,
+                   uint32_t new_leaf) noexcept {
+        for (size_t i = first; i <= last; ++i) {
+            uint32_t e = table[i].load(std::memory_order_relaxed);
+            if (e & PTR) {
+                Chunk& child = *chunks_[e & 0xFFFF];
+                fillRange(child, 0, 255, new_leaf);
+            } else if (!(e & SET) || leafLen(e) <= leafLen(new_leaf)) {
+                table[i].store(new_leaf, std::memory_order_release);
+            }
+        }
+    }
+
+    // Insert into one level. bit_offset = bits already consumed above
+    // this level, stride = bits this level indexes.
+    template<typename Table>
+    bool insertLevel(Table& table, uint32_t prefix, uint8_t len,
+                     uint8_t value, unsigned bit_offset,
+                     unsigned stride) noexcept {
+        unsigned remaining = len - bit_offset;
+        uint32_t index = (prefix >> (32 - bit_offset - stride)) &
+                         ((1u << stride) - 1);
+
+        if (remaining <= stride) {
+            // Prefix ends at this level: cover the whole index range
+            size_t span = size_t{1} << (stride - remaining);
+            size_t first = index & ~(span - 1);
+            fillRange(table, first, first + span - 1, leaf(value, len));
+            return true;
+        }
+
+        // Prefix is longer: descend, expanding a leaf into a chunk first
+        uint32_t e = table[index].load(std::memory_order_relaxed);
+        if (!(e & PTR)) {
+            Chunk* child = claimChunk();
+            if (!child) return false; // table full - rule kept, applied on rebuild
+            uint32_t idx = static_cast<uint32_t>(chunks_used_ - 1);
+            uint32_t inherit = (e & SET) ? e : 0;
+            for (auto& slot : *child) {
+                slot.store(inherit, std::memory_order_relaxed);
+            }
+            // Publish the chunk only after its contents are in place
+            table[index].store(PTR | idx, std::memory_order_release);
+            e = PTR | idx;
+        }
+
+        return insertLevel(*chunks_[e & 0xFFFF], prefix, len, value,
+                           bit_offset + stride, 8);
+    }
+
+    void insertRule(const Rule& r) noexcept {
+        insertLevel(*root_, r.prefix, r.len, r.value, 0, 16);
+    }
+
+    void rebuildLocked() noexcept {
+        chunks_used_ = 0;
+        for (auto& slot : *root_) {
+            slot.store(0, std::memory_order_relaxed);
+        }
+        for (const auto& r : rules_) {
+            insertRule(r);
+        }
+    }
+
+public:
+    LpmTable()
+        : root_(std::make_unique<std::array<std::atomic<uint32_t>, 65536>>())
+    {
+        for (auto& slot : *root_) {
+            slot.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    LpmTable(const LpmTable&) = delete;
+    LpmTable& operator=(const LpmTable&) = delete;
+
+    // HOT PATH: at most three dependent loads, no locks
+    [[nodiscard]] std::optional<uint8_t> lookup(uint32_t ip) const noexcept {
+        uint32_t e = (*root_)[ip >> 16].load(std::memory_order_acquire);
+        if (e & PTR) {
+            e = (*chunks_[e & 0xFFFF])[(ip >> 8) & 0xFF]
+                    .load(std::memory_order_acquire);
+            if (e & PTR) {
+                e = (*chunks_[e & 0xFFFF])[ip & 0xFF]
+                        .load(std::memory_order_acquire);
+            }
+        }
+        if (e & SET) return static_cast<uint8_t>(e & 0xFF);
+        return std::nullopt;
+    }
+
+    // Lock-free guard so callers with zero CIDR rules skip the probe
+    [[nodiscard]] bool empty() const noexcept {
+        return rule_count_.load(std::memory_order_relaxed) == 0;
+    }
+
+    [[nodiscard]] size_t size() const noexcept {
+        return rule_count_.load(std::memory_order_relaxed);
+    }
+
+    // Insert (or update) a prefix. len 0..32; host routes are just /32.
+    bool insert(uint32_t prefix, uint8_t len, uint8_t value) {
+        if (len > 32) return false;
+        prefix &= (len == 0) ? 0 : (0xFFFFFFFFu << (32 - len));
+
+        std::lock_guard lock(write_mutex_);
+
+        for (auto& r : rules_) {
+            if (r.prefix == prefix && r.len == len) {
+                r.value = value;
+                insertRule(r);
+                return true;
+            }
+        }
+
+        rules_.push_back({prefix, len, value});
+        rule_count_.store(rules_.size(), std::memory_order_relaxed);
+        insertRule(rules_.back());
+        return true;
+    }
+
+    // Remove a prefix; rebuilds the structure from the remaining rules
+    bool remove(uint32_t prefix, uint8_t len) {
+        if (len > 32) return false;
+        prefix &= (len == 0) ? 0 : (0xFFFFFFFFu << (32 - len));
+
+        std::lock_guard lock(write_mutex_);
+
+        for (auto it = rules_.begin(); it != rules_.end(); ++it) {
+            if (it->prefix == prefix && it->len == len) {
+                rules_.erase(it);
+                rule_count_.store(rules_.size(), std::memory_order_relaxed);
+                rebuildLocked();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Snapshot the rule list (control plane / reporting)
+    template<typename Fn>
+    void forEach(Fn&& fn) const {
+        std::lock_guard lock(write_mutex_);
+        for (const auto& r : rules_) {
+            fn(r.prefix, r.len, r.value);
+        }
+    }
+};
+
+} // namespace gw::perf
@@ -0,0 +1,69 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace gw::perf {
+
+// Adaptive spin-then-park waiter for queue consumers.
+//
+// Under load a consumer spins briefly (no syscalls, lowest wakeup latency);
+// when the queue stays empty it parks on a condition variable and stops
+// burning cycles. Producers call notifyOne() after publishing - that is a
+// single relaxed load when nobody is parked, so the loaded fast path pays
+// almost nothing for the parking layer.
+//
+// Parked waits re-check the caller's predicate under the mutex and use a
+// bounded timeout as a safety net, so a wakeup racing the park can at worst
+// cost one timeout period, never a hang.
+class ConsumerParker {
+private:
+    static constexpr std::chrono::milliseconds PARK_TIMEOUT{10};
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::atomic<uint32_t> waiters_{0};
+
+public:
+    ConsumerParker() = default;
+
+    // Non-copyable
+    ConsumerParker(const ConsumerParker&) = delete;
+    ConsumerParker& operator=(const ConsumerParker&) = delete;
+
+    // Consumer side: spin for spin_iterations polls of has_work(), then
+    // park until notified (or the safety timeout expires).
+    template<typename HasWork>
+    void parkUntil(HasWork&& has_work, uint32_t spin_iterations) {
+        for (uint32_t i = 0; i < spin_iterations; ++i) {
+            if (has_work()) return;
+            std::this_thread::yield();
+        }
+
+        std::unique_lock lock(mutex_);
+        waiters_.fetch_add(1, std::memory_order_release);
+        cv_.wait_for(lock, PARK_TIMEOUT, has_work);
+        waiters_.fetch_sub(1, std::memory_order_release);
+    }
+
+    // Producer side: call after publishing work. No-op unless a consumer
+    // is actually parked.
+    void notifyOne() noexcept {
+        if (waiters_.load(std::memory_order_acquire) == 0) return;
+
+        // Empty critical section: orders this wakeup after a racing
+        // consumer's predicate check inside wait_for
+        { std::lock_guard lock(mutex_); }
+        cv_.notify_one();
+    }
+
+    // Shutdown: wake everyone regardless of queue state
+    void notifyAll() noexcept {
+        { std::lock_guard lock(mutex_); }
+        cv_.notify_all();
+    }
+};
+
+} // namespace gw::perf
@@ -0,0 +1,337 @@
+#pragma once
+#include "lock_free.hpp"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+
+namespace gw::perf {
+
+// Sharded, open-addressed concurrent block table (fixed size, no allocation).
+//
+// Built for the hottest path in the engine: checking whether a source IP is
+// blocked while an attack is in progress. Readers (contains) are fully
+// lock-free - a bounded linear probe over atomic keys plus one atomic load
+// of the expiry timestamp. Writers (block/unblock/sweep) take a per-shard
+// mutex; block events are orders of magnitude rarer than lookups, and
+// sharding means a sweep of one shard never stalls lookups or writes
+// elsewhere.
+//
+// Deletion never resets a key slot to 0 (that would break probe chains);
+// instead the expiry timestamp is zeroed and the slot becomes reusable by
+// a later insert. Probes are bounded by MAX_PROBE so a full shard degrades
+// to a miss instead of an unbounded scan.
+template<size_t NumShards = 16, size_t ShardCapacity = 1024>
+class ShardedBlockTable {
+public:
+    static constexpr uint64_t PERMANENT_NS = UINT64_MAX;
+
+    // Read-only view of a live entry (used for iteration/reporting)
+    struct EntryView {
+        uint32_t key;
+        uint64_t blocked_at_ns;
+        uint64_t expires_at_ns;
+        uint32_t violation_count;
+        uint8_t reason;
+        // blockOrExtend only: true when this call (re)installed the block
+        // in a slot whose previous block was already reclaimed (new slot,
+        // or one freed by erase/sweep) - i.e. derived caches hold no bits
+        // for it and must add them. False for a live extension or for the
+        // revival of an expired entry the sweep has not reclaimed yet,
+        // where the caches are still populated.
+        bool fresh = false;
+    };
+
+private:
+    static constexpr size_t MAX_PROBE = 64;
+
+    struct Entry {
+        std::atomic<uint32_t> key{0};            // 0 = never used (end of chain)
+        std::atomic<uint64_t> expires_at_ns{0};  // 0 = expired/free slot
+        std::atomic<uint64_t> blocked_at_ns{0};
+        std::atomic<uint32_t> violation_count{0};
+        std::atomic<uint8_t> reason{0};
+    };
+
+    struct alignas(CACHE_LINE_SIZE) Shard {
+        std::array<Entry, ShardCapacity> entries{};
+        std::mutex write_mutex;
+    };
+
+    std::array<Shard, NumShards> shards_;
+    std::atomic<size_t> active_{0}; // approximate live-entry count
+
+    static constexpr uint32_t hash(uint32_t key) noexcept {
+        // MurmurHash3 finalizer (same mix as FastHashMap)
+        key ^= key >> 16;
+        key *= 0x85ebca6b;
+        key ^= key >> 13;
+        key *= 0xc2b2ae35;
+        key ^= key >> 16;
+        return key;
+    }
+
+    static constexpr size_t shardIndex(uint32_t h) noexcept {
+        return h % NumShards;
+    }
+
+    static constexpr size_t slotIndex(uint32_t h) noexcept {
+        return (h / NumShards) % ShardCapacity;
+    }
+
+public:
+    ShardedBlockTable() = default;
+
+    // Non-copyable (atomics)
+    ShardedBlockTable(const ShardedBlockTable&) = delete;
+    ShardedBlockTable& operator=(const ShardedBlockTable&) = delete;
+
+    // HOT PATH: lock-free probe. Returns true if key has a live block.
+    bool contains(uint32_t key, uint64_t now_ns) const noexcept {
+        uint32_t h = hash(key);
+        const Shard& shard = shards_[shardIndex(h)];
+        size_t idx = slotIndex(h);
+
+        for (size_t probe = 0; probe < MAX_PROBE; ++probe) {
+            const Entry& e = shard.entries[(idx + probe) % ShardCapacity];
+            uint32_t k = e.key.load(std::memory_order_acquire);
+
+            if (k == 0) return false; // end of probe chain
+
+            if (k == key) {
+                return e.expires_at_ns.load(std::memory_order_acquire) > now_ns;
+            }
+        }
+
+        return false;
+    }
+
+    // Insert a new block or extend an existing one. After permanent_after
+    // violations the entry becomes permanent. Returns the resulting entry
+    // state (for journaling/reporting), or nullopt only if the probe
+    // window is completely full of live entries.
+    std::optional<EntryView> blockOrExtend(uint32_t key, uint8_t reason,
+                                           uint64_t now_ns,
+                                           uint64_t duration_ns,
+                                           uint32_t permanent_after) noexcept {
+        uint32_t h = hash(key);
+        Shard& shard = shards_[shardIndex(h)];
+        std::lock_guard lock(shard.write_mutex);
+
+        size_t idx = slotIndex(h);
+        Entry* free_slot = nullptr;
+
+        for (size_t probe = 0; probe < MAX_PROBE; ++probe) {
+            Entry& e = shard.entries[(idx + probe) % ShardCapacity];
+            uint32_t k = e.key.load(std::memory_order_relaxed);
+
+            if (k == key) {
+                // Extend existing block
+                uint32_t violations =
+                    e.violation_count.fetch_add(1, std::memory_order_relaxed) + 1;
+
+                uint64_t current = e.expires_at_ns.load(std::memory_order_relaxed);
+                if (current != PERMANENT_NS) {
+                    bool was_live = current > now_ns;
+                    uint64_t expires =
+                        (permanent_after > 0 && violations >= permanent_after)
+                            ? PERMANENT_NS
+                            : now_ns + duration_ns;
+                    e.expires_at_ns.store(expires, std::memory_order_release);
+                    if (!was_live) {
+                        active_.fetch_add(1, std::memory_order_relaxed);
+                    }
+                }
+
+                e.reason.store(reason, std::memory_order_relaxed);
+                return EntryView{
+                    key,
+                    e.blocked_at_ns.load(std::memory_order_relaxed),
+                    e.expires_at_ns.load(std::memory_order_relaxed),
+                    violations,
+                    reason,
+                    // A freed slot (erase or sweep set expires to 0) had
+                    // its derived-cache bits removed; reviving it is a
+                    // fresh block from the caches' point of view
+                    /*fresh=*/current == 0
+                };
+            }
+
+            if (k == 0) {
+                // End of chain - claim this slot unless we already found
+                // an expired one to reuse
+                if (!free_slot) free_slot = &e;
+                break;
+            }
+
+            // Expired entries are reusable, but keep scanning in case the
+            // key exists further down the chain
+            if (!free_slot &&
+                e.expires_at_ns.load(std::memory_order_relaxed) <= now_ns) {
+                free_slot = &e;
+            }
+        }
+
+        if (!free_slot) return std::nullopt; // probe window full of live entries
+
+        // Publish the new entry: fields first, key (with release) last so
+        // a concurrent lock-free reader never sees a stale expiry
+        free_slot->blocked_at_ns.store(now_ns, std::memory_order_relaxed);
+        free_slot->violation_count.store(1, std::memory_order_relaxed);
+        free_slot->reason.store(reason, std::memory_order_relaxed);
+        free_slot->expires_at_ns.store(now_ns + duration_ns, std::memory_order_relaxed);
+        free_slot->key.store(key, std::memory_order_release);
+
+        active_.fetch_add(1, std::memory_order_relaxed);
+        return EntryView{key, now_ns, now_ns + duration_ns, 1, reason,
+                         /*fresh=*/true};
+    }
+
+    // Reinstall an entry with absolute state (journal replay at startup).
+    // Same slot-claim logic as blockOrExtend, but nothing is derived from
+    // "now": expiry, violation count and permanence come straight from the
+    // persisted record.
+    bool restore(uint32_t key, uint8_t reason, uint64_t blocked_at_ns,
+                 uint64_t expires_at_ns, uint32_t violation_count,
+                 uint64_t now_ns) noexcept {
+        uint32_t h = hash(key);
+        Shard& shard = shards_[shardIndex(h)];
+        std::lock_guard lock(shard.write_mutex);
+
+        size_t idx = slotIndex(h);
+        Entry* slot = nullptr;
+
+        for (size_t probe = 0; probe < MAX_PROBE; ++probe) {
+            Entry& e = shard.entries[(idx + probe) % ShardCapacity];
+            uint32_t k = e.key.load(std::memory_order_relaxed);
+
+            if (k == key) {
+                slot = &e; // overwrite: last journal record wins
+                break;
+            }
+            if (k == 0) {
+                if (!slot) slot = &e;
+                break;
+            }
+            if (!slot &&
+                e.expires_at_ns.load(std::memory_order_relaxed) <= now_ns) {
+                slot = &e;
+            }
+        }
+
+        if (!slot) return false;
+
+        bool was_live =
+            slot->key.load(std::memory_order_relaxed) == key &&
+            slot->expires_at_ns.load(std::memory_order_relaxed) > now_ns;
+
+        slot->blocked_at_ns.store(blocked_at_ns, std::memory_order_relaxed);
+        slot->violation_count.store(violation_count, std::memory_order_relaxed);
+        slot->reason.store(reason, std::memory_order_relaxed);
+        slot->expires_at_ns.store(expires_at_ns, std::memory_order_relaxed);
+        slot->key.store(key, std::memory_order_release);
+
+        if (!was_live && expires_at_ns > now_ns) {
+            active_.fetch_add(1, std::memory_order_relaxed);
+        }
+        return true;
+    }
+
+    // Remove a block (logically - the key slot stays to keep chains intact).
+    // Returns true if a live entry was removed.
+    bool erase(uint32_t key, uint64_t now_ns) noexcept {
+        uint32_t h = hash(key);
+        Shard& shard = shards_[shardIndex(h)];
+        std::lock_guard lock(shard.write_mutex);
+
+        size_t idx = slotIndex(h);
+
+        for (size_t probe = 0; probe < MAX_PROBE; ++probe) {
+            Entry& e = shard.entries[(idx + probe) % ShardCapacity];
+            uint32_t k = e.key.load(std::memory_order_relaxed);
+
+            if (k == 0) return false;
+
+            if (k == key) {
+                bool was_live =
+                    e.expires_at_ns.load(std::memory_order_relaxed) > now_ns;
+                e.expires_at_ns.store(0, std::memory_order_release);
+                if (was_live) {
+                    active_.fetch_sub(1, std::memory_order_relaxed);
+                }
+                return was_live;
+            }
+        }
+
+        return false;
+    }
+
+    // Sweep expired entries shard by shard (each shard locked independently,
+    // lookups never stall). Invokes on_expired(key) for each entry reclaimed
+    // by this sweep so callers can purge derived caches (e.g. the engine's
+    // blocked-IP filter). Returns the number of still-live entries.
+    template<typename Fn>
+    size_t sweep(uint64_t now_ns, Fn&& on_expired) noexcept {
+        size_t live = 0;
+
+        for (auto& shard : shards_) {
+            std::lock_guard lock(shard.write_mutex);
+
+            for (auto& e : shard.entries) {
+                uint32_t k = e.key.load(std::memory_order_relaxed);
+                if (k == 0) continue;
+
+                uint64_t expires = e.expires_at_ns.load(std::memory_order_relaxed);
+                if (expires == 0) continue; // already freed
+
+                if (expires <= now_ns) {
+                    e.expires_at_ns.store(0, std::memory_order_release);
+                    on_expired(k);
+                } else {
+                    live++;
+                }
+            }
+        }
+
+        active_.store(live, std::memory_order_relaxed);
+        return live;
+    }
+
+    size_t sweep(uint64_t now_ns) noexcept {
+        return sweep(now_ns, [](uint32_t) {});
+    }
+
+    // Visit every live entry (lock-free snapshot; entries may expire
+    // concurrently - callers get a best-effort view)
+    template<typename Fn>
+    void forEach(uint64_t now_ns, Fn&& fn) const {
+        for (const auto& shard : shards_) {
+            for (const auto& e : shard.entries) {
+                uint32_t k = e.key.load(std::memory_order_acquire);
+                if (k == 0) continue;
+
+                uint64_t expires = e.expires_at_ns.load(std::memory_order_acquire);
+                if (expires <= now_ns) continue;
+
+                fn(EntryView{
+                    k,
+                    e.blocked_at_ns.load(std::memory_order_relaxed),
+                    expires,
+                    e.violation_count.load(std::memory_order_relaxed),
+                    e.reason.load(std::memory_order_relaxed)
+                });
+            }
+        }
+    }
+
+    size_t activeCount() const noexcept {
+        return active_.load(std::memory_order_relaxed);
+    }
+
+    static constexpr size_t capacity() noexcept {
+        return NumShards * ShardCapacity;
+    }
+};
+
+} // namespace gw::perf
@@ -0,0 +1,75 @@
+#pragma once
+#include "lock_free.hpp"
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace gw::perf {
+
+// Stable per-thread shard slot, shared by every sharded structure so a
+// worker always lands on the same cache line everywhere. Assigned once per
+// thread on first use; callers reduce modulo their own shard count.
+inline size_t threadShardSlot() noexcept {
+    static std::atomic<size_t> next_slot{0};
+    thread_local const size_t slot =
+        next_slot.fetch_add(1, std::memory_order_relaxed);
+    return slot;
+}
+
+// Sharded monotonic counter: the write side is a relaxed increment to a
+// cache-line-padded per-thread slot, so concurrent workers never ping-pong
+// a shared line. Reads (sum) walk all shards - fine for snapshot-style
+// reporting, which is orders of magnitude rarer than increments.
+//
+// Decrements are supported: individual shards may wrap below zero, but
+// unsigned wraparound makes the cross-shard sum come out right.
+template<size_t NumShards = 16>
+class ShardedCounter {
+private:
+    struct alignas(CACHE_LINE_SIZE) Shard {
+        std::atomic<uint64_t> value{0};
+    };
+
+    std::array<Shard, NumShards> shards_;
+
+    Shard& localShard() noexcept {
+        return shards_[threadShardSlot() % NumShards];
+    }
+
+public:
+    ShardedCounter() = default;
+
+    // Non-copyable (atomics)
+    ShardedCounter(const ShardedCounter&) = delete;
+    ShardedCounter& operator=(const ShardedCounter&) = delete;
+
+    // HOT PATH: uncontended relaxed add on the caller's own line
+    void increment() noexcept {
+        localShard().value.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void add(uint64_t n) noexcept {
+        localShard().value.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    void decrement() noexcept {
+        localShard().value.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    // Read side: sum across shards (snapshot/reporting only)
+    uint64_t sum() const noexcept {
+        uint64_t total = 0;
+        for (const auto& shard : shards_) {
+            total += shard.value.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    void reset() noexcept {
+        for (auto& shard : shards_) {
+            shard.value.store(0, std::memory_order_relaxed);
+        }
+    }
+};
+
+} // namespace gw::perf
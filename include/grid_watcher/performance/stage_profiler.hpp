@@ -0,0 +1,203 @@
+#pragma once
+#include "sharded_counter.hpp"
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+#if defined(GW_PROFILE_STAGES) && defined(__x86_64__)
+#include <x86intrin.h>
+#elif defined(GW_PROFILE_STAGES)
+#include <chrono>
+#endif
+
+namespace gw::perf {
+
+// ============================================================================
+// Per-stage hot-path cycle profiler
+// ============================================================================
+// Answers "where do the cycles go per packet" with stage-granular rdtsc
+// deltas instead of whole-path latency: the existing latency histogram says
+// a packet took 900ns, this says 600 of them were the behavioral rules.
+//
+// Compiled out entirely unless GW_PROFILE_STAGES is defined (the CMake
+// option of the same name): the disabled build sees empty constexpr stubs
+// that fold to zero instructions, so call sites stay in the hot path
+// unconditionally. When compiled in, the cost per sampled packet is one
+// rdtsc pair per stage plus relaxed adds to a cache-line-padded per-thread
+// shard - and sampling every Nth packet (runtime knob) bounds even that
+// for always-on production use.
+//
+// Counts are raw TSC cycles (cntvct ticks on ARM64): stable for comparing
+// stages against each other, which is the whole point - convert to ns
+// offline if absolute numbers are needed.
+
+// Stage boundaries mirror GridWatcher::processPacket / runDetectionPath
+enum class Stage : uint8_t {
+    FAST_PATH = 0,  // bloom filters + subnet LPM pre-checks
+    PARSE,          // buildPacketMetadata (protocol detect + parse)
+    RATE_LIMIT,     // mitigation shouldDropPacket
+    ANALYZE,        // behavioral analyzer rules
+    MITIGATE,       // threat loop: log + journal + mitigate
+    COUNT
+};
+
+inline constexpr size_t STAGE_COUNT = static_cast<size_t>(Stage::COUNT);
+
+constexpr const char* stageName(Stage s) noexcept {
+    switch (s) {
+        case Stage::FAST_PATH:  return "fast_path";
+        case Stage::PARSE:      return "parse";
+        case Stage::RATE_LIMIT: return "rate_limit";
+        case Stage::ANALYZE:    return "analyze";
+        case Stage::MITIGATE:   return "mitigate";
+        default:                return "unknown";
+    }
+}
+
+// Snapshot shape is identical in both builds so getMetrics() and the
+// exporters compile the same either way (disabled build reads zeros)
+struct StageSnapshot {
+    std::array<uint64_t, STAGE_COUNT> cycles{};
+    std::array<uint64_t, STAGE_COUNT> samples{};
+
+    [[nodiscard]] double avgCycles(Stage s) const noexcept {
+        const auto i = static_cast<size_t>(s);
+        return samples[i] > 0
+            ? static_cast<double>(cycles[i]) / static_cast<double>(samples[i])
+            : 0.0;
+    }
+};
+
+#ifdef GW_PROFILE_STAGES
+
+class StageProfiler {
+private:
+    static constexpr size_t NUM_SHARDS = 16;
+
+    // Same sharding scheme as ShardedCounter: workers land on a stable
+    // padded slot, so concurrent recording never ping-pongs a line
+    struct alignas(CACHE_LINE_SIZE) Shard {
+        std::array<std::atomic<uint64_t>, STAGE_COUNT> cycles{};
+        std::array<std::atomic<uint64_t>, STAGE_COUNT> samples{};
+    };
+
+    std::array<Shard, NUM_SHARDS> shards_;
+    std::atomic<uint32_t> sample_interval_{1};
+
+public:
+    static constexpr bool ENABLED = true;
+
+    [[nodiscard]] static uint64_t readCycles() noexcept {
+#if defined(__x86_64__)
+        return __rdtsc();
+#elif defined(__aarch64__)
+        uint64_t v;
+        asm volatile("mrs %0, cntvct_el0" : "=r"(v));
+        return v;
+#else
+        return static_cast<uint64_t>(
+            std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+    }
+
+    // Every-Nth-packet sampling decision, made once per packet so all
+    // stages of one packet are sampled together. Per-thread countdown:
+    // no shared state on the decision path.
+    [[nodiscard]] bool shouldSample() noexcept {
+        const uint32_t n = sample_interval_.load(std::memory_order_relaxed);
+        if (LIKELY(n <= 1)) return true;
+        thread_local uint32_t countdown = 0;
+        if (countdown == 0) {
+            countdown = n - 1;
+            return true;
+        }
+        --countdown;
+        return false;
+    }
+
+    // Runtime knob: 1 = every packet, N = every Nth (0 treated as 1)
+    void setSampleInterval(uint32_t n) noexcept {
+        sample_interval_.store(n == 0 ? 1 : n, std::memory_order_relaxed);
+    }
+
+    void record(Stage s, uint64_t cycles) noexcept {
+        auto& shard = shards_[threadShardSlot() % NUM_SHARDS];
+        const auto i = static_cast<size_t>(s);
+        shard.cycles[i].fetch_add(cycles, std::memory_order_relaxed);
+        shard.samples[i].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] StageSnapshot snapshot() const noexcept {
+        StageSnapshot snap;
+        for (const auto& shard : shards_) {
+            for (size_t i = 0; i < STAGE_COUNT; ++i) {
+                snap.cycles[i] +=
+                    shard.cycles[i].load(std::memory_order_relaxed);
+                snap.samples[i] +=
+                    shard.samples[i].load(std::memory_order_relaxed);
+            }
+        }
+        return snap;
+    }
+};
+
+// Scoped stage timer: records on destruction (covers early returns) or
+// on an explicit finish() where a stage ends mid-scope
+class StageTimer {
+private:
+    StageProfiler& profiler_;
+    Stage stage_;
+    uint64_t start_;
+    bool active_;
+
+public:
+    StageTimer(StageProfiler& profiler, Stage stage, bool active) noexcept
+        : profiler_(profiler)
+        , stage_(stage)
+        , start_(active ? StageProfiler::readCycles() : 0)
+        , active_(active) {}
+
+    ~StageTimer() {
+        finish();
+    }
+
+    StageTimer(const StageTimer&) = delete;
+    StageTimer& operator=(const StageTimer&) = delete;
+
+    void finish() noexcept {
+        if (!active_) return;
+        active_ = false;
+        profiler_.record(stage_, StageProfiler::readCycles() - start_);
+    }
+};
+
+#else // !GW_PROFILE_STAGES
+
+// Zero-cost stubs: shouldSample() is a constant false, so the profile
+// flag threaded through the hot path constant-folds and every timer
+// disappears under optimization
+class StageProfiler {
+public:
+    static constexpr bool ENABLED = false;
+
+    [[nodiscard]] static constexpr bool shouldSample() noexcept {
+        return false;
+    }
+
+    static constexpr void setSampleInterval(uint32_t) noexcept {}
+    static constexpr void record(Stage, uint64_t) noexcept {}
+
+    [[nodiscard]] static constexpr StageSnapshot snapshot() noexcept {
+        return {};
+    }
+};
+
+class StageTimer {
+public:
+    constexpr StageTimer(StageProfiler&, Stage, bool) noexcept {}
+    constexpr void finish() const noexcept {}
+};
+
+#endif // GW_PROFILE_STAGES
+
+} // namespace gw::perf
@@ -0,0 +1,45 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <utility>
+
+namespace gw::perf {
+
+// Fixed-capacity inline vector: storage lives in the object itself, so a
+// hot path can collect a small bounded result set with zero heap traffic.
+// Deliberately minimal - default-constructible elements, overwrite on
+// emplace, no exceptions: a full buffer just rejects the element (callers
+// size N to the worst case, so rejection means a logic error upstream).
+template<typename T, size_t N>
+class StaticVector {
+    static_assert(N > 0);
+
+    std::array<T, N> data_{};
+    size_t count_{0};
+
+public:
+    constexpr StaticVector() noexcept = default;
+
+    template<typename... Args>
+    constexpr bool emplace_back(Args&&... args) noexcept {
+        if (count_ >= N) return false;
+        data_[count_++] = T(std::forward<Args>(args)...);
+        return true;
+    }
+
+    constexpr void clear() noexcept { count_ = 0; }
+
+    [[nodiscard]] constexpr size_t size() const noexcept { return count_; }
+    [[nodiscard]] constexpr bool empty() const noexcept { return count_ == 0; }
+    [[nodiscard]] static constexpr size_t capacity() noexcept { return N; }
+
+    constexpr T& operator[](size_t i) noexcept { return data_[i]; }
+    constexpr const T& operator[](size_t i) const noexcept { return data_[i]; }
+
+    constexpr T* begin() noexcept { return data_.data(); }
+    constexpr T* end() noexcept { return data_.data() + count_; }
+    constexpr const T* begin() const noexcept { return data_.data(); }
+    constexpr const T* end() const noexcept { return data_.data() + count_; }
+};
+
+} // namespace gw::perf
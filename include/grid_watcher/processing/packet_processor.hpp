@@ -2,6 +2,10 @@
 
 #include "../grid_watcher.hpp"
 #include "../performance/lock_free.hpp"
+#include "../performance/huge_pages.hpp"
+#include "../performance/sharded_counter.hpp"
+#include "../performance/parking.hpp"
+#include "../performance/buffer_pool.hpp"
 #include <thread>
 #include <vector>
 #include <atomic>
@@ -14,23 +18,21 @@ namespace gw::processing {
 // ============================================================================
 struct PacketJob {
     std::chrono::steady_clock::time_point received_at;
-    std::vector<std::byte> data;
+    perf::PooledBuffer data; // slab from the processor's pool, auto-recycled
     net::ipv4 source_ip;
     net::ipv4 dest_ip;
     uint16_t source_port;
     uint16_t dest_port;
     
-    // Result - changed to regular bool for copyability
     bool processed{false};
     bool allowed{true};
     
     // Default constructor
     PacketJob() = default;
     
-    // Allow copy and move
-    PacketJob(const PacketJob&) = default;
+    // Move-only: the pooled buffer has exactly one owner, and every queue
+    // in this file hands jobs over by move anyway
     PacketJob(PacketJob&&) noexcept = default;
-    PacketJob& operator=(const PacketJob&) = default;
     PacketJob& operator=(PacketJob&&) noexcept = default;
 };
 
@@ -47,12 +49,14 @@ private:
         Slot() : sequence(0) {}
     };
     
-    std::vector<Slot> slots_;
+    // Huge-page-backed: 32K slots are walked by sequence from several
+    // cores - large pages keep the slot array to a handful of TLB entries
+    perf::HugeArray<Slot, Capacity> slots_;
     alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> enqueue_pos_{0};
     alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> dequeue_pos_{0};
-    
+
 public:
-    PacketQueue() : slots_(Capacity) {
+    PacketQueue() {
         for (size_t i = 0; i < Capacity; ++i) {
             slots_[i].sequence.store(i, std::memory_order_relaxed);
         }
@@ -103,6 +107,11 @@ public:
             }
         }
     }
+    
+    bool empty() const noexcept {
+        return dequeue_pos_.load(std::memory_order_acquire) ==
+               enqueue_pos_.load(std::memory_order_acquire);
+    }
 };
 
 // ============================================================================
@@ -112,11 +121,14 @@ class PacketProcessor {
 private:
     scada::GridWatcher& watcher_;
     PacketQueue<32768> queue_; // 32K packet queue
+    perf::PacketBufferPool buffer_pool_;
     
     std::vector<std::thread> workers_;
     std::atomic<bool> running_{false};
     size_t num_threads_;
     
+    perf::ConsumerParker parker_;
+    
     // Performance statistics
     alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> packets_queued_{0};
     alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> packets_processed_{0};
@@ -156,6 +168,8 @@ public:
     void stop() {
         if (!running_.exchange(false)) return;
         
+        parker_.notifyAll(); // release parked workers
+        
         for (auto& worker : workers_) {
             if (worker.joinable()) {
                 worker.join();
@@ -164,14 +178,15 @@ public:
         workers_.clear();
     }
     
-    // Submit packet for processing (non-blocking)
-    bool submitPacket(std::vector<std::byte> data,
+    // Submit packet for processing (non-blocking). The payload is copied
+    // into a pool slab, so the submit path performs no heap allocation.
+    bool submitPacket(std::span<const std::byte> data,
                      const net::ipv4& src_ip,
                      const net::ipv4& dst_ip,
                      uint16_t src_port,
                      uint16_t dst_port) noexcept {
         PacketJob job;
-        job.data = std::move(data);
+        job.data = perf::PooledBuffer(buffer_pool_, data);
         job.source_ip = src_ip;
         job.dest_ip = dst_ip;
         job.source_port = src_port;
@@ -180,6 +195,7 @@ public:
         
         if (queue_.enqueue(std::move(job))) {
             packets_queued_.fetch_add(1, std::memory_order_relaxed);
+            parker_.notifyOne(); // cheap no-op unless a worker is parked
             return true;
         }
         
@@ -212,12 +228,13 @@ private:
         #endif
         
         PacketJob job;
+        const uint32_t spin = watcher_.getConfig().worker_spin_iterations;
         
         while (running_.load(std::memory_order_relaxed)) {
             if (queue_.dequeue(job)) {
                 // Process packet
                 bool allowed = watcher_.processPacket(
-                    job.data,
+                    job.data.view(),
                     job.source_ip,
                     job.dest_ip,
                     job.source_port,
@@ -229,8 +246,244 @@ private:
                 
                 packets_processed_.fetch_add(1, std::memory_order_relaxed);
             } else {
-                // Queue empty, yield CPU
-                std::this_thread::yield();
+                // Queue empty: spin briefly, then park until the producer
+                // wakes us (keeps idle CPU near zero on fanless boxes)
+                parker_.parkUntil([this] {
+                    return !running_.load(std::memory_order_relaxed) ||
+                           !queue_.empty();
+                }, spin);
+            }
+        }
+    }
+};
+
+// ============================================================================
+// Flow-Affinity Sharded Processor (SPSC queues + work stealing)
+// ============================================================================
+// submitPacket hashes the source IP to pick a worker, so every packet of a
+// flow lands on the same core: the analyzer's per-IP stats lines stay hot
+// in one core's cache instead of ping-ponging, and the shared MPMC queue's
+// enqueue/dequeue CAS contention disappears (each worker drains its own
+// SPSC ring).
+//
+// An idle worker steals from neighbour queues so one hot flow cannot leave
+// the other cores spinning. Stealing makes the consume side momentarily
+// multi-consumer, so every pop goes through a per-queue flag - the owner
+// acquires it uncontended in the common case, stealers only when idle.
+class ShardedPacketProcessor {
+private:
+    static constexpr size_t QUEUE_CAPACITY = 4096;
+
+    struct alignas(CACHE_LINE_SIZE) WorkerQueue {
+        perf::LockFreeRingBuffer<PacketJob, QUEUE_CAPACITY> ring;
+        std::atomic_flag consuming = ATOMIC_FLAG_INIT;
+        perf::ConsumerParker parker;
+    };
+
+    scada::GridWatcher& watcher_;
+    perf::PacketBufferPool buffer_pool_;
+    std::vector<std::unique_ptr<WorkerQueue>> queues_;
+    std::vector<std::thread> workers_;
+    std::atomic<bool> running_{false};
+    std::atomic<size_t> queues_ready_{0};
+    size_t num_threads_;
+    uint32_t spin_iterations_{4000};
+
+    // Performance statistics
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> packets_queued_{0};
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> packets_dropped_queue_full_{0};
+    perf::ShardedCounter<16> packets_processed_;
+    perf::ShardedCounter<16> packets_stolen_;
+
+    static constexpr uint32_t hash(uint32_t key) noexcept {
+        // MurmurHash3 finalizer (same mix as FastHashMap)
+        key ^= key >> 16;
+        key *= 0x85ebca6b;
+        key ^= key >> 13;
+        key *= 0xc2b2ae35;
+        key ^= key >> 16;
+        return key;
+    }
+
+    // Pin the CALLING thread so flow affinity translates into cache (and
+    // NUMA) locality
+    static void pinToCore(size_t i) noexcept {
+        #ifdef __linux__
+        cpu_set_t cpuset;
+        CPU_ZERO(&cpuset);
+        CPU_SET(i % std::thread::hardware_concurrency(), &cpuset);
+        pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuset);
+        #else
+        (void)i;
+        #endif
+    }
+
+public:
+    explicit ShardedPacketProcessor(scada::GridWatcher& watcher,
+                                   size_t num_threads = std::thread::hardware_concurrency())
+        : watcher_(watcher)
+        , num_threads_(num_threads > 0 ? num_threads : 1)
+    {
+        // Queues are NOT allocated here: each worker constructs its own in
+        // start() after pinning itself, so on a multi-socket collector the
+        // ring is first-touched - and therefore physically placed - on the
+        // NUMA node of the core that will drain it
+        queues_.resize(num_threads_);
+    }
+
+    ~ShardedPacketProcessor() {
+        stop();
+    }
+
+    void start() {
+        if (running_.exchange(true)) return;
+
+        spin_iterations_ = watcher_.getConfig().worker_spin_iterations;
+
+        for (size_t i = 0; i < num_threads_; ++i) {
+            workers_.emplace_back([this, i]() {
+                // Pin FIRST, then allocate: the first write to each queue
+                // page faults it onto this core's local NUMA node
+                pinToCore(i);
+                queues_[i] = std::make_unique<WorkerQueue>();
+                queues_ready_.fetch_add(1, std::memory_order_release);
+
+                // Work stealing reads neighbour queues - wait until every
+                // shard exists before processing begins
+                while (queues_ready_.load(std::memory_order_acquire) <
+                       num_threads_) {
+                    std::this_thread::yield();
+                }
+
+                workerThread(i);
+            });
+        }
+
+        // submitPacket may run the moment start() returns
+        while (queues_ready_.load(std::memory_order_acquire) < num_threads_) {
+            std::this_thread::yield();
+        }
+    }
+
+    void stop() {
+        if (!running_.exchange(false)) return;
+
+        for (auto& queue : queues_) {
+            queue->parker.notifyAll(); // release parked workers
+        }
+
+        for (auto& worker : workers_) {
+            if (worker.joinable()) {
+                worker.join();
+            }
+        }
+        workers_.clear();
+    }
+
+    // Submit packet for processing: same flow always maps to the same worker
+    bool submitPacket(std::span<const std::byte> data,
+                     const net::ipv4& src_ip,
+                     const net::ipv4& dst_ip,
+                     uint16_t src_port,
+                     uint16_t dst_port) noexcept {
+        // Queues exist only after start() (workers first-touch their own)
+        if (UNLIKELY(!running_.load(std::memory_order_relaxed))) {
+            return false;
+        }
+
+        PacketJob job;
+        job.data = perf::PooledBuffer(buffer_pool_, data);
+        job.source_ip = src_ip;
+        job.dest_ip = dst_ip;
+        job.source_port = src_port;
+        job.dest_port = dst_port;
+        job.received_at = std::chrono::steady_clock::now();
+
+        size_t target = hash(src_ip.to_uint32()) % num_threads_;
+
+        if (queues_[target]->ring.push(std::move(job))) {
+            packets_queued_.fetch_add(1, std::memory_order_relaxed);
+            queues_[target]->parker.notifyOne();
+            return true;
+        }
+
+        packets_dropped_queue_full_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    struct Stats {
+        uint64_t packets_queued;
+        uint64_t packets_processed;
+        uint64_t packets_dropped_queue_full;
+        uint64_t packets_stolen;
+    };
+
+    Stats getStats() const noexcept {
+        return Stats{
+            packets_queued_.load(std::memory_order_relaxed),
+            packets_processed_.sum(),
+            packets_dropped_queue_full_.load(std::memory_order_relaxed),
+            packets_stolen_.sum()
+        };
+    }
+
+private:
+    // Pop under the per-queue consume flag (owner path is uncontended)
+    bool tryConsume(WorkerQueue& queue, PacketJob& job) noexcept {
+        if (queue.consuming.test_and_set(std::memory_order_acquire)) {
+            return false; // someone else is draining this queue
+        }
+        bool ok = queue.ring.pop(job);
+        queue.consuming.clear(std::memory_order_release);
+        return ok;
+    }
+
+    void processJob(PacketJob& job) noexcept {
+        job.allowed = watcher_.processPacket(
+            job.data.view(),
+            job.source_ip,
+            job.dest_ip,
+            job.source_port,
+            job.dest_port
+        );
+        job.processed = true;
+        packets_processed_.increment();
+    }
+
+    void workerThread(size_t worker_id) {
+        #ifdef __linux__
+        std::string name = "gw-shard-" + std::to_string(worker_id);
+        pthread_setname_np(pthread_self(), name.c_str());
+        #endif
+
+        PacketJob job;
+
+        while (running_.load(std::memory_order_relaxed)) {
+            // Own queue first (flow-affine fast path)
+            if (tryConsume(*queues_[worker_id], job)) {
+                processJob(job);
+                continue;
+            }
+
+            // Idle: steal from the nearest busy neighbour
+            bool stole = false;
+            for (size_t k = 1; k < num_threads_; ++k) {
+                size_t victim = (worker_id + k) % num_threads_;
+                if (tryConsume(*queues_[victim], job)) {
+                    packets_stolen_.increment();
+                    processJob(job);
+                    stole = true;
+                    break;
+                }
+            }
+
+            if (!stole) {
+                // Nothing anywhere: spin briefly, then park on our own
+                // queue's waker (the producer wakes the flow's owner)
+                queues_[worker_id]->parker.parkUntil([this, worker_id] {
+                    return !running_.load(std::memory_order_relaxed) ||
+                           !queues_[worker_id]->ring.empty();
+                }, spin_iterations_);
             }
         }
     }
@@ -243,13 +496,16 @@ class BatchPacketProcessor {
 private:
     scada::GridWatcher& watcher_;
     static constexpr size_t BATCH_SIZE = 64;
-    
-    struct Batch {
-        std::array<PacketJob, BATCH_SIZE> jobs;
-        size_t count{0};
-    };
-    
-    perf::LockFreeRingBuffer<Batch, 512> batch_queue_;
+    static constexpr size_t QUEUE_CAPACITY = 8192;
+
+    // Jobs are queued individually and move through the ring with the
+    // bulk API: submitBatch is one push_bulk (single index update for the
+    // whole span), a worker refills with one pop_bulk of up to BATCH_SIZE.
+    // Several workers drain the same SPSC ring, so the consume side is
+    // serialized with a flag - same pattern as ShardedPacketProcessor.
+    perf::LockFreeRingBuffer<PacketJob, QUEUE_CAPACITY> job_queue_;
+    std::atomic_flag consuming_ = ATOMIC_FLAG_INIT;
+    perf::ConsumerParker parker_;
     std::vector<std::thread> workers_;
     std::atomic<bool> running_{false};
     
@@ -265,6 +521,7 @@ public:
     
     ~BatchPacketProcessor() {
         running_.store(false);
+        parker_.notifyAll(); // release parked workers
         for (auto& w : workers_) {
             if (w.joinable()) w.join();
         }
@@ -272,37 +529,62 @@ public:
     
     bool submitBatch(std::vector<PacketJob> jobs) {
         if (jobs.size() > BATCH_SIZE) return false;
-        
-        Batch batch;
-        batch.count = jobs.size();
-        for (size_t i = 0; i < jobs.size(); ++i) {
-            batch.jobs[i] = std::move(jobs[i]);
+
+        // All-or-nothing: the batch either fits or is rejected whole
+        if (job_queue_.size() + jobs.size() > QUEUE_CAPACITY) return false;
+        if (job_queue_.push_bulk(std::span<PacketJob>(jobs)) != jobs.size()) {
+            return false;
         }
-        
-        return batch_queue_.push(batch);
+        parker_.notifyOne();
+        return true;
     }
-    
+
 private:
+    // Pop a refill under the consume flag (the ring is SPSC; multiple
+    // workers drain it, so pops are serialized)
+    size_t tryConsume(std::span<PacketJob> out) noexcept {
+        if (consuming_.test_and_set(std::memory_order_acquire)) {
+            return 0; // another worker is draining
+        }
+        size_t count = job_queue_.pop_bulk(out);
+        consuming_.clear(std::memory_order_release);
+        return count;
+    }
+
     void batchWorker() {
-        Batch batch;
-        
+        static_assert(BATCH_SIZE <= scada::GridWatcher::MAX_BATCH_SIZE,
+                      "Batch must fit in one verdict bitmap");
+
+        std::array<PacketJob, BATCH_SIZE> jobs;
+        std::array<scada::PacketView, BATCH_SIZE> views;
+
         while (running_.load(std::memory_order_relaxed)) {
-            if (batch_queue_.pop(batch)) {
-                // Process entire batch
-                for (size_t i = 0; i < batch.count; ++i) {
-                    auto& job = batch.jobs[i];
-                    bool allowed = watcher_.processPacket(
-                        job.data,
+            if (size_t count = tryConsume(jobs); count > 0) {
+                // Build non-owning views and feed the whole batch at once
+                for (size_t i = 0; i < count; ++i) {
+                    const auto& job = jobs[i];
+                    views[i] = scada::PacketView{
+                        job.data.view(),
                         job.source_ip,
                         job.dest_ip,
                         job.source_port,
                         job.dest_port
-                    );
-                    job.allowed = allowed;
-                    job.processed = true;
+                    };
+                }
+
+                uint64_t verdicts = watcher_.processPacketBatch(
+                    std::span<const scada::PacketView>(views.data(), count)
+                );
+
+                for (size_t i = 0; i < count; ++i) {
+                    jobs[i].allowed = (verdicts >> i) & 1ULL;
+                    jobs[i].processed = true;
                 }
             } else {
-                std::this_thread::yield();
+                parker_.parkUntil([this] {
+                    return !running_.load(std::memory_order_relaxed) ||
+                           !job_queue_.empty();
+                }, watcher_.getConfig().worker_spin_iterations);
             }
         }
     }
@@ -0,0 +1,561 @@
+#pragma once
+
+#include "../grid_watcher.hpp"
+#include "../core/tcp_socket.hpp"
+#include "../core/socket_base.hpp"
+#include <atomic>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/uio.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace gw::proxy {
+
+// ============================================================================
+// Inline Transparent Proxy (enforcement mode, Linux only)
+// ============================================================================
+// The pcap path observes a COPY of traffic that has already reached the
+// PLC - verdicts there are forensic, not protective. This engine puts the
+// verdict physically in-path for the bays that need it: it terminates the
+// HMI-side TCP session, runs every complete Modbus ADU through
+// GridWatcher::processPacket, and only then lets bytes continue to the
+// PLC.
+//
+// Latency budget (the reason for every design choice below):
+//   - one epoll thread, no handoff to a worker pool: a frame goes
+//     recv -> verdict -> writev inside a single wakeup
+//   - TCP_NODELAY on both legs (set by BaseSocket::create), so a verdict
+//     never waits out a Nagle timer
+//   - pipelined requests are gathered into ONE writev: the iovecs point
+//     straight into the session's receive buffer, so allowed payload
+//     bytes are never copied in user space
+//   - the PLC->HMI leg carries responses we already let happen; it is
+//     relayed kernel-to-kernel with splice() through a per-session pipe
+//     and never surfaces into user space at all
+//
+// Blocked verdicts: the frame is simply not forwarded (the HMI sees a
+// timeout, the PLC sees nothing). If the verdict escalated to a block of
+// the source IP (MitigationAction::BLOCK_IP), the session is torn down
+// with an RST so the operator station fails fast instead of retrying
+// into a dead filter.
+#ifdef __linux__
+
+class InlineProxy {
+private:
+    static constexpr int MAX_EVENTS = 64;
+    static constexpr int EPOLL_TIMEOUT_MS = 500;
+    static constexpr size_t READ_CHUNK = 16 * 1024;
+    static constexpr size_t SPLICE_CHUNK = 64 * 1024;
+
+    // MBAP: transaction(2) protocol(2) length(2) unit(1); length counts
+    // unit + PDU, PDU caps at 253 -> a legal ADU never exceeds 260 bytes
+    static constexpr size_t MBAP_HEADER_SIZE = 7;
+    static constexpr size_t MAX_ADU_SIZE = 260;
+
+    // Per-direction backpressure cap: a stalled peer parks the session
+    // instead of growing buffers without bound
+    static constexpr size_t MAX_PENDING = 256 * 1024;
+
+    struct Session {
+        net::TcpSocket hmi;
+        net::TcpSocket plc;
+        net::ipv4 hmi_ip;
+        uint16_t hmi_port{0};
+
+        std::vector<uint8_t> hmi_in;   // bytes from HMI awaiting framing
+        std::vector<uint8_t> to_plc;   // allowed bytes a full writev missed
+
+        // Response leg: PLC -> pipe -> HMI, all via splice
+        int pipe_fds[2]{-1, -1};
+        size_t pipe_filled{0};         // bytes parked in the pipe
+
+        bool plc_want_write{false};
+        bool hmi_want_write{false};
+
+        Session(net::TcpSocket&& h, net::TcpSocket&& p)
+            : hmi(std::move(h)), plc(std::move(p)) {}
+
+        ~Session() {
+            if (pipe_fds[0] >= 0) ::close(pipe_fds[0]);
+            if (pipe_fds[1] >= 0) ::close(pipe_fds[1]);
+        }
+    };
+
+    // Both fds of a session land in the same epoll set; the side tag
+    // tells the handler which leg fired
+    struct FdRef {
+        Session* session;
+        bool is_plc_side;
+    };
+
+    scada::GridWatcher& watcher_;
+    net::SocketAddress listen_addr_;
+    net::SocketAddress plc_addr_;
+
+    std::unordered_map<int, FdRef> fds_;
+    std::vector<std::unique_ptr<Session>> sessions_;
+
+    std::atomic<bool> running_{false};
+    std::thread proxy_thread_;
+    int epoll_fd_{-1};
+    int wake_fd_{-1};
+
+    // Statistics (cache-aligned, same layout as the capture engines)
+    alignas(64) std::atomic<uint64_t> frames_forwarded_{0};
+    alignas(64) std::atomic<uint64_t> frames_blocked_{0};
+    alignas(64) std::atomic<uint64_t> sessions_accepted_{0};
+    alignas(64) std::atomic<uint64_t> sessions_reset_{0};
+
+public:
+    InlineProxy(scada::GridWatcher& watcher,
+                const net::SocketAddress& listen_addr,
+                const net::SocketAddress& plc_addr)
+        : watcher_(watcher)
+        , listen_addr_(listen_addr)
+        , plc_addr_(plc_addr)
+    {}
+
+    ~InlineProxy() {
+        stop();
+    }
+
+    InlineProxy(const InlineProxy&) = delete;
+    InlineProxy& operator=(const InlineProxy&) = delete;
+
+    void start() {
+        if (running_.exchange(true)) return;
+        proxy_thread_ = std::thread([this]() { eventLoop(); });
+    }
+
+    void stop() {
+        if (!running_.exchange(false)) return;
+
+        if (wake_fd_ >= 0) {
+            uint64_t one = 1;
+            [[maybe_unused]] ssize_t n = write(wake_fd_, &one, sizeof(one));
+        }
+        if (proxy_thread_.joinable()) {
+            proxy_thread_.join();
+        }
+    }
+
+    struct Stats {
+        uint64_t frames_forwarded;
+        uint64_t frames_blocked;
+        uint64_t sessions_accepted;
+        uint64_t sessions_reset;
+        size_t sessions_active;
+    };
+
+    [[nodiscard]] Stats getStats() const noexcept {
+        return {
+            frames_forwarded_.load(std::memory_order_relaxed),
+            frames_blocked_.load(std::memory_order_relaxed),
+            sessions_accepted_.load(std::memory_order_relaxed),
+            sessions_reset_.load(std::memory_order_relaxed),
+            sessions_.size()
+        };
+    }
+
+private:
+    // ========================================================================
+    // Event Loop
+    // ========================================================================
+    void eventLoop() {
+        net::TcpListener listener;
+        try {
+            listener.listen(listen_addr_);
+            listener.setNonBlocking(true);
+        } catch (const std::exception& e) {
+            std::cerr << "[PROXY] Failed to listen on "
+                      << listen_addr_.toString() << ": " << e.what() << "\n";
+            running_ = false;
+            return;
+        }
+
+        epoll_fd_ = epoll_create1(0);
+        wake_fd_ = eventfd(0, EFD_NONBLOCK);
+        if (epoll_fd_ < 0 || wake_fd_ < 0) {
+            std::cerr << "[PROXY] epoll/eventfd setup failed\n";
+            running_ = false;
+            return;
+        }
+
+        addFd(listener.getHandle(), EPOLLIN);
+        addFd(wake_fd_, EPOLLIN);
+
+        std::cout << "[PROXY] Inline enforcement on "
+                  << listen_addr_.toString() << " -> "
+                  << plc_addr_.toString() << "\n";
+
+        struct epoll_event events[MAX_EVENTS];
+
+        while (running_.load(std::memory_order_relaxed)) {
+            int n = epoll_wait(epoll_fd_, events, MAX_EVENTS, EPOLL_TIMEOUT_MS);
+
+            for (int i = 0; i < n; ++i) {
+                int fd = events[i].data.fd;
+
+                if (fd == listener.getHandle()) {
+                    acceptSessions(listener);
+                } else if (fd == wake_fd_) {
+                    uint64_t drained;
+                    [[maybe_unused]] ssize_t r =
+                        read(wake_fd_, &drained, sizeof(drained));
+                } else {
+                    handleEvent(fd, events[i].events);
+                }
+            }
+        }
+
+        fds_.clear();
+        sessions_.clear();
+        close(wake_fd_);
+        wake_fd_ = -1;
+        close(epoll_fd_);
+        epoll_fd_ = -1;
+    }
+
+    void addFd(int fd, uint32_t events) {
+        struct epoll_event ev{};
+        ev.events = events;
+        ev.data.fd = fd;
+        epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &ev);
+    }
+
+    void modFd(int fd, uint32_t events) {
+        struct epoll_event ev{};
+        ev.events = events;
+        ev.data.fd = fd;
+        epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, fd, &ev);
+    }
+
+    // ========================================================================
+    // Session Setup / Teardown
+    // ========================================================================
+    void acceptSessions(net::TcpListener& listener) {
+        for (;;) {
+            auto hmi = listener.accept();
+            if (!hmi) break;
+
+            // An already-blocked source does not even get a PLC connection
+            auto remote = hmi->getRemoteAddress();
+            if (!remote || watcher_.isIPBlocked(remote->getAddress())) {
+                continue; // destructor closes the socket
+            }
+
+            net::TcpSocket plc;
+            try {
+                plc.connect(plc_addr_);
+            } catch (const std::exception& e) {
+                std::cerr << "[PROXY] Upstream connect failed: "
+                          << e.what() << "\n";
+                continue;
+            }
+
+            hmi->setNonBlocking(true);
+            plc.setNonBlocking(true);
+
+            auto session = std::make_unique<Session>(std::move(*hmi),
+                                                     std::move(plc));
+            session->hmi_ip = remote->getAddress();
+            session->hmi_port = remote->getPort();
+
+            if (pipe2(session->pipe_fds, O_NONBLOCK) != 0) {
+                continue; // session destructor cleans up both sockets
+            }
+
+            int hmi_fd = session->hmi.getHandle();
+            int plc_fd = session->plc.getHandle();
+            fds_[hmi_fd] = {session.get(), false};
+            fds_[plc_fd] = {session.get(), true};
+            addFd(hmi_fd, EPOLLIN);
+            addFd(plc_fd, EPOLLIN);
+
+            sessions_.push_back(std::move(session));
+            sessions_accepted_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    void closeSession(Session* session) {
+        // closing the fds removes them from the epoll set automatically
+        fds_.erase(session->hmi.getHandle());
+        fds_.erase(session->plc.getHandle());
+
+        for (auto it = sessions_.begin(); it != sessions_.end(); ++it) {
+            if (it->get() == session) {
+                sessions_.erase(it);
+                return;
+            }
+        }
+    }
+
+    // Teardown with RST instead of FIN: SO_LINGER{1,0} makes close() send
+    // a reset, so the blocked HMI fails immediately instead of waiting
+    // out retransmissions into a half-open session
+    void resetSession(Session* session) {
+        struct linger lin{1, 0};
+        setsockopt(session->hmi.getHandle(), SOL_SOCKET, SO_LINGER,
+                   &lin, sizeof(lin));
+        sessions_reset_.fetch_add(1, std::memory_order_relaxed);
+        closeSession(session);
+    }
+
+    // ========================================================================
+    // Event Dispatch
+    // ========================================================================
+    void handleEvent(int fd, uint32_t events) {
+        auto it = fds_.find(fd);
+        if (it == fds_.end()) return;
+        Session* session = it->second.session;
+
+        if (events & (EPOLLHUP | EPOLLERR)) {
+            closeSession(session);
+            return;
+        }
+
+        bool alive = it->second.is_plc_side
+                   ? handlePlcEvent(session, events)
+                   : handleHmiEvent(session, events);
+        if (!alive) return;
+
+        // Re-arm writability only while a direction has backlog
+        bool plc_write = !session->to_plc.empty();
+        if (plc_write != session->plc_want_write) {
+            session->plc_want_write = plc_write;
+            modFd(session->plc.getHandle(),
+                  EPOLLIN | (plc_write ? EPOLLOUT : 0u));
+        }
+        bool hmi_write = session->pipe_filled > 0;
+        if (hmi_write != session->hmi_want_write) {
+            session->hmi_want_write = hmi_write;
+            modFd(session->hmi.getHandle(),
+                  EPOLLIN | (hmi_write ? EPOLLOUT : 0u));
+        }
+    }
+
+    // ========================================================================
+    // HMI -> PLC (inspected leg)
+    // ========================================================================
+    bool handleHmiEvent(Session* session, uint32_t events) {
+        if (events & EPOLLOUT) {
+            if (!drainPipeToHmi(session)) {
+                closeSession(session);
+                return false;
+            }
+        }
+
+        if (!(events & EPOLLIN)) return true;
+
+        if (session->hmi_in.size() + session->to_plc.size() > MAX_PENDING) {
+            return true; // backpressure: leave bytes in the kernel buffer
+        }
+
+        size_t old_size = session->hmi_in.size();
+        session->hmi_in.resize(old_size + READ_CHUNK);
+        ssize_t n = ::recv(session->hmi.getHandle(),
+                           session->hmi_in.data() + old_size, READ_CHUNK, 0);
+        if (n <= 0) {
+            session->hmi_in.resize(old_size);
+            if (n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK &&
+                           errno != EINTR)) {
+                closeSession(session);
+                return false;
+            }
+            return true;
+        }
+        session->hmi_in.resize(old_size + static_cast<size_t>(n));
+
+        return inspectAndForward(session);
+    }
+
+    // Frame the receive buffer into ADUs, collect the allowed ones as
+    // iovecs pointing INTO the buffer, ship them with one writev
+    bool inspectAndForward(Session* session) {
+        auto& buf = session->hmi_in;
+        std::array<struct iovec, MAX_EVENTS> iov;
+        size_t iov_count = 0;
+        size_t consumed = 0;
+
+        while (buf.size() - consumed >= MBAP_HEADER_SIZE) {
+            const uint8_t* frame = buf.data() + consumed;
+            size_t adu_len = 6 + (static_cast<size_t>(frame[4]) << 8 | frame[5]);
+
+            if (adu_len < MBAP_HEADER_SIZE || adu_len > MAX_ADU_SIZE) {
+                // Not framable as Modbus/TCP: an inline filter cannot pass
+                // what it cannot inspect
+                frames_blocked_.fetch_add(1, std::memory_order_relaxed);
+                resetSession(session);
+                return false;
+            }
+            if (buf.size() - consumed < adu_len) break; // partial frame
+
+            bool allowed = watcher_.processPacket(
+                std::span<const std::byte>(
+                    reinterpret_cast<const std::byte*>(frame), adu_len),
+                session->hmi_ip,
+                plc_addr_.getAddress(),
+                session->hmi_port,
+                plc_addr_.getPort());
+
+            if (LIKELY(allowed)) {
+                if (iov_count == iov.size() && !flushIov(session, iov, iov_count)) {
+                    closeSession(session);
+                    return false;
+                }
+                iov[iov_count].iov_base = const_cast<uint8_t*>(frame);
+                iov[iov_count].iov_len = adu_len;
+                ++iov_count;
+                frames_forwarded_.fetch_add(1, std::memory_order_relaxed);
+            } else {
+                frames_blocked_.fetch_add(1, std::memory_order_relaxed);
+                // Escalated to a source block: kill the session outright
+                if (watcher_.isIPBlocked(session->hmi_ip)) {
+                    resetSession(session);
+                    return false;
+                }
+                // Otherwise the frame just vanishes; the session lives on
+            }
+            consumed += adu_len;
+        }
+
+        if (!flushIov(session, iov, iov_count)) {
+            closeSession(session);
+            return false;
+        }
+        buf.erase(buf.begin(),
+                  buf.begin() + static_cast<std::ptrdiff_t>(consumed));
+        return true;
+    }
+
+    // One gather-write for every allowed frame of this wakeup. Bytes the
+    // kernel would not take land in to_plc and finish under EPOLLOUT.
+    bool flushIov(Session* session, std::array<struct iovec, MAX_EVENTS>& iov,
+                  size_t& iov_count) {
+        if (iov_count == 0) return true;
+
+        if (session->to_plc.empty()) {
+            ssize_t sent = ::writev(session->plc.getHandle(),
+                                    iov.data(), static_cast<int>(iov_count));
+            if (sent < 0) {
+                if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                    return false;
+                }
+                sent = 0;
+            }
+            // Skip fully-written iovecs, queue the remainder
+            size_t remaining = static_cast<size_t>(sent);
+            for (size_t i = 0; i < iov_count; ++i) {
+                if (remaining >= iov[i].iov_len) {
+                    remaining -= iov[i].iov_len;
+                    continue;
+                }
+                const auto* base =
+                    static_cast<const uint8_t*>(iov[i].iov_base) + remaining;
+                session->to_plc.insert(session->to_plc.end(), base,
+                                       base + (iov[i].iov_len - remaining));
+                remaining = 0;
+            }
+        } else {
+            // Older bytes are still queued: keep ordering, append behind
+            for (size_t i = 0; i < iov_count; ++i) {
+                const auto* base = static_cast<const uint8_t*>(iov[i].iov_base);
+                session->to_plc.insert(session->to_plc.end(), base,
+                                       base + iov[i].iov_len);
+            }
+        }
+
+        iov_count = 0;
+        return true;
+    }
+
+    // ========================================================================
+    // PLC -> HMI (response leg: splice, bytes never enter user space)
+    // ========================================================================
+    bool handlePlcEvent(Session* session, uint32_t events) {
+        if (events & EPOLLOUT) {
+            if (!flushToPlc(session)) {
+                closeSession(session);
+                return false;
+            }
+        }
+
+        if (!(events & EPOLLIN)) return true;
+
+        for (;;) {
+            if (session->pipe_filled >= MAX_PENDING) break; // backpressure
+
+            ssize_t n = splice(session->plc.getHandle(), nullptr,
+                               session->pipe_fds[1], nullptr, SPLICE_CHUNK,
+                               SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+            if (n > 0) {
+                session->pipe_filled += static_cast<size_t>(n);
+                continue;
+            }
+            if (n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK &&
+                           errno != EINTR)) {
+                closeSession(session);
+                return false;
+            }
+            break; // kernel buffer drained
+        }
+
+        if (!drainPipeToHmi(session)) {
+            closeSession(session);
+            return false;
+        }
+        return true;
+    }
+
+    bool drainPipeToHmi(Session* session) {
+        while (session->pipe_filled > 0) {
+            ssize_t n = splice(session->pipe_fds[0], nullptr,
+                               session->hmi.getHandle(), nullptr,
+                               session->pipe_filled,
+                               SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+            if (n > 0) {
+                session->pipe_filled -= static_cast<size_t>(n);
+                continue;
+            }
+            if (n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK &&
+                           errno != EINTR)) {
+                return false;
+            }
+            break; // HMI not writable: EPOLLOUT re-arms us
+        }
+        return true;
+    }
+
+    bool flushToPlc(Session* session) {
+        while (!session->to_plc.empty()) {
+            ssize_t n = ::send(session->plc.getHandle(),
+                               session->to_plc.data(),
+                               session->to_plc.size(), 0);
+            if (n > 0) {
+                session->to_plc.erase(
+                    session->to_plc.begin(),
+                    session->to_plc.begin() + static_cast<std::ptrdiff_t>(n));
+                continue;
+            }
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                return false;
+            }
+            break;
+        }
+        return true;
+    }
+};
+
+#endif // __linux__
+
+} // namespace gw::proxy
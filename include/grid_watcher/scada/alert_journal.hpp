@@ -0,0 +1,275 @@
+#pragma once
+
+// ============================================================================
+// Threat-alert journal - memory-mapped, binary, circular.
+//
+// Forensics used to ride the text Logger: every threat was rendered to a
+// formatted line and competed with routine log traffic for the same
+// 8192-slot ring, so logs_dropped_ climbed exactly when the alerts
+// mattered most. This journal gives alerts their own channel: each
+// ThreatAlert becomes one fixed 32-byte record written straight into a
+// size-capped mmap'd file - no allocation, no formatting, no contention
+// with the logger. When the file fills, the oldest alerts are overwritten
+// (loss is bounded and newest-first), and the binary records replay
+// byte-for-byte into the export tool.
+//
+// Appends are lock-free multi-producer: a worker claims a slot with one
+// fetch_add on the mapped cursor, writes the record, then publishes the
+// per-record sequence number last. A reader (or a crash) sees either a
+// fully-written record whose sequence matches its slot generation, or a
+// stale/torn one it can skip - the header cursor is never ahead of what
+// can be validated record-by-record.
+//
+// Durability mirrors BlockJournal: appends only touch the mapping, the
+// monitor thread msyncs periodically, so a crash loses at most one
+// monitor interval of alerts. POSIX mmap only; on other platforms the
+// class compiles to a disabled stub.
+// ============================================================================
+
+#include "types.hpp"
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <atomic>
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace gw::scada {
+
+class AlertJournal {
+public:
+    static constexpr uint32_t MAGIC = 0x4757414A;  // "GWAJ"
+    static constexpr uint32_t VERSION = 1;
+    static constexpr size_t CAPACITY_RECORDS = 131072;  // 4MB record area
+
+    // Fixed 32-byte record. seq is the claim index + 1, written LAST: a
+    // slot is valid only while its seq matches the generation the cursor
+    // implies, so torn or overwritten records are detectable.
+    struct Record {
+        uint64_t seq;
+        uint64_t timestamp_ns;
+        uint32_t source_ip;
+        uint32_t dest_ip;
+        uint8_t attack_type;
+        uint8_t severity;
+        uint8_t auto_mitigated;
+        uint8_t reserved;
+        float confidence;
+    };
+    static_assert(sizeof(Record) == 32, "journal record must stay fixed-size");
+
+private:
+    struct Header {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t next_seq;    // total records ever claimed (monotonic)
+        uint64_t reserved[2];
+    };
+    static_assert(sizeof(Header) == 32);
+
+    static constexpr size_t FILE_SIZE =
+        sizeof(Header) + CAPACITY_RECORDS * sizeof(Record);
+
+#ifndef _WIN32
+    int fd_{-1};
+    uint8_t* map_{nullptr};
+    bool read_only_{false};
+
+    Header* header() const noexcept {
+        return reinterpret_cast<Header*>(map_);
+    }
+    Record* records() const noexcept {
+        return reinterpret_cast<Record*>(map_ + sizeof(Header));
+    }
+#endif
+
+public:
+    AlertJournal() = default;
+
+    ~AlertJournal() {
+        closeFile();
+    }
+
+    AlertJournal(const AlertJournal&) = delete;
+    AlertJournal& operator=(const AlertJournal&) = delete;
+
+#ifndef _WIN32
+    // Open (or create) the journal for appending. Returns false on any
+    // file error - the engine then runs without the journal rather than
+    // refusing to start.
+    bool open(const std::string& path) noexcept {
+        closeFile();
+        read_only_ = false;
+
+        fd_ = ::open(path.c_str(), O_RDWR | O_CREAT, 0600);
+        if (fd_ < 0) return false;
+
+        struct stat st{};
+        if (fstat(fd_, &st) < 0) {
+            closeFile();
+            return false;
+        }
+
+        bool fresh = (st.st_size == 0);
+        if (static_cast<size_t>(st.st_size) != FILE_SIZE) {
+            if (ftruncate(fd_, static_cast<off_t>(FILE_SIZE)) < 0) {
+                closeFile();
+                return false;
+            }
+            fresh = fresh || (st.st_size != 0);
+        }
+
+        map_ = static_cast<uint8_t*>(
+            mmap(nullptr, FILE_SIZE, PROT_READ | PROT_WRITE,
+                 MAP_SHARED, fd_, 0));
+        if (map_ == MAP_FAILED) {
+            map_ = nullptr;
+            closeFile();
+            return false;
+        }
+
+        if (fresh || header()->magic != MAGIC ||
+            header()->version != VERSION) {
+            std::memset(map_, 0, FILE_SIZE);
+            header()->magic = MAGIC;
+            header()->version = VERSION;
+        }
+
+        return true;
+    }
+
+    // Read-only mapping for the export tool: never creates or resizes
+    bool openReadOnly(const std::string& path) noexcept {
+        closeFile();
+        read_only_ = true;
+
+        fd_ = ::open(path.c_str(), O_RDONLY);
+        if (fd_ < 0) return false;
+
+        struct stat st{};
+        if (fstat(fd_, &st) < 0 ||
+            static_cast<size_t>(st.st_size) != FILE_SIZE) {
+            closeFile();
+            return false;
+        }
+
+        map_ = static_cast<uint8_t*>(
+            mmap(nullptr, FILE_SIZE, PROT_READ, MAP_SHARED, fd_, 0));
+        if (map_ == MAP_FAILED) {
+            map_ = nullptr;
+            closeFile();
+            return false;
+        }
+
+        if (header()->magic != MAGIC || header()->version != VERSION) {
+            closeFile();
+            return false;
+        }
+        return true;
+    }
+
+    [[nodiscard]] bool isOpen() const noexcept { return map_ != nullptr; }
+
+    // HOT PATH: claim a slot (one fetch_add), write the record, publish
+    // its sequence number last. No locks, no allocation, no syscalls.
+    void append(const ThreatAlert& alert) noexcept {
+        if (!map_ || read_only_) return;
+
+        uint64_t seq = std::atomic_ref<uint64_t>(header()->next_seq)
+                           .fetch_add(1, std::memory_order_relaxed);
+        Record& rec = records()[seq % CAPACITY_RECORDS];
+
+        std::atomic_ref<uint64_t>(rec.seq).store(0, std::memory_order_relaxed);
+        rec.timestamp_ns = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                alert.timestamp.time_since_epoch()).count());
+        rec.source_ip = alert.source_ip.to_uint32();
+        rec.dest_ip = alert.dest_ip.to_uint32();
+        rec.attack_type = static_cast<uint8_t>(alert.attack_type);
+        rec.severity = static_cast<uint8_t>(alert.severity);
+        rec.auto_mitigated = alert.auto_mitigated ? 1 : 0;
+        rec.reserved = 0;
+        rec.confidence = static_cast<float>(alert.confidence_score);
+
+        std::atomic_ref<uint64_t>(rec.seq)
+            .store(seq + 1, std::memory_order_release);
+    }
+
+    // Walk the retained alerts oldest-first. fn(const Record&) is called
+    // only for records whose sequence validates against their slot
+    // generation (torn or mid-overwrite slots are skipped). Returns the
+    // number of valid records visited.
+    template<typename Fn>
+    size_t forEach(Fn&& fn) const noexcept {
+        if (!map_) return 0;
+
+        uint64_t next = std::atomic_ref<uint64_t>(header()->next_seq)
+                            .load(std::memory_order_acquire);
+        uint64_t first = (next > CAPACITY_RECORDS)
+                       ? next - CAPACITY_RECORDS : 0;
+
+        size_t visited = 0;
+        for (uint64_t i = first; i < next; ++i) {
+            const Record& rec = records()[i % CAPACITY_RECORDS];
+            if (std::atomic_ref<const uint64_t>(rec.seq)
+                    .load(std::memory_order_acquire) != i + 1) {
+                continue; // torn, or already overwritten by a newer claim
+            }
+            fn(rec);
+            ++visited;
+        }
+        return visited;
+    }
+
+    [[nodiscard]] uint64_t totalAppended() const noexcept {
+        if (!map_) return 0;
+        return std::atomic_ref<uint64_t>(header()->next_seq)
+                   .load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] static constexpr size_t capacity() noexcept {
+        return CAPACITY_RECORDS;
+    }
+
+    // Sync the mapping to disk. Called from the monitor thread - never
+    // from the packet path.
+    void flush() noexcept {
+        if (!map_ || read_only_) return;
+        msync(map_, FILE_SIZE, MS_SYNC);
+    }
+
+private:
+    void closeFile() noexcept {
+        if (map_) {
+            if (!read_only_) msync(map_, FILE_SIZE, MS_SYNC);
+            munmap(map_, FILE_SIZE);
+            map_ = nullptr;
+        }
+        if (fd_ >= 0) {
+            ::close(fd_);
+            fd_ = -1;
+        }
+    }
+
+#else
+    // Windows stub: alerts stay on the text logger only
+    bool open(const std::string&) noexcept { return false; }
+    bool openReadOnly(const std::string&) noexcept { return false; }
+    [[nodiscard]] bool isOpen() const noexcept { return false; }
+    void append(const ThreatAlert&) noexcept {}
+    template<typename Fn> size_t forEach(Fn&&) const noexcept { return 0; }
+    [[nodiscard]] uint64_t totalAppended() const noexcept { return 0; }
+    [[nodiscard]] static constexpr size_t capacity() noexcept { return 0; }
+    void flush() noexcept {}
+
+private:
+    void closeFile() noexcept {}
+#endif
+};
+
+} // namespace gw::scada
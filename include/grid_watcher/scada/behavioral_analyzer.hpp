@@ -3,9 +3,12 @@
 #include "config.hpp"
 #include "../performance/fast_hash.hpp"
 #include "../performance/lock_free.hpp"
+#include "../performance/static_vector.hpp"
 #include <atomic>
 #include <array>
 #include <vector>
+#include <algorithm>
+#include <optional>
 #include <chrono>
 
 namespace gw::scada {
@@ -19,45 +22,63 @@ struct alignas(CACHE_LINE_SIZE) FastTrafficStats {
     std::atomic<uint32_t> exception_count{0};
     alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> first_seen_ns{0};
     std::atomic<uint64_t> last_seen_ns{0};
+    // Windowed rate estimator: window_count accumulates the current
+    // 1-second window; when the second rolls over, the completed window is
+    // folded into packets_per_second as an EWMA (alpha = 1/2). A lifetime
+    // average was useless here - an hour of polite polling buried a 100k
+    // pps burst; the EWMA reflects the last few seconds and decays by
+    // half for each idle second.
+    std::atomic<uint64_t> window_sec{0};
+    std::atomic<uint32_t> window_count{0};
     std::atomic<uint32_t> packets_per_second{0};
-    
+
     void update(const PacketMetadata& pkt) noexcept {
         packet_count.fetch_add(1, std::memory_order_relaxed);
         byte_count.fetch_add(pkt.packet_size, std::memory_order_relaxed);
-        
-        auto now = std::chrono::steady_clock::now().time_since_epoch().count();
+
+        // Coarse clock: one relaxed load instead of a vDSO call per packet
+        auto now = static_cast<int64_t>(perf::CoarseClock::steadyNs());
         last_seen_ns.store(now, std::memory_order_relaxed);
-        
+
         uint64_t expected = 0;
         first_seen_ns.compare_exchange_weak(expected, now, std::memory_order_relaxed);
-        
+
+        // Rate window roll-over: one tick comparison per packet; exactly
+        // one thread wins the CAS per second and folds the window in
+        uint64_t sec = static_cast<uint64_t>(now) / 1000000000ULL;
+        uint64_t cur = window_sec.load(std::memory_order_relaxed);
+        if (UNLIKELY(sec != cur) &&
+            window_sec.compare_exchange_strong(cur, sec,
+                                               std::memory_order_relaxed)) {
+            uint32_t completed = window_count.exchange(0, std::memory_order_relaxed);
+            uint32_t rate = packets_per_second.load(std::memory_order_relaxed);
+
+            if (cur == 0) {
+                rate = 0; // first window for this IP
+            } else {
+                // Decay for idle seconds between windows, then blend
+                uint64_t idle = sec - cur - 1;
+                rate = (idle < 32) ? (rate >> idle) : 0;
+                rate = (rate >> 1) + (completed >> 1) + (completed & 1);
+            }
+            packets_per_second.store(rate, std::memory_order_relaxed);
+        }
+        window_count.fetch_add(1, std::memory_order_relaxed);
+
         if (pkt.has_exception) {
             exception_count.fetch_add(1, std::memory_order_relaxed);
         }
-        
-        uint8_t fc = static_cast<uint8_t>(pkt.function_code);
-        bool is_write = (fc >= 0x05 && fc <= 0x06) || (fc >= 0x0F && fc <= 0x10);
-        bool is_read = (fc >= 0x01 && fc <= 0x04);
-        
-        write_count.fetch_add(is_write, std::memory_order_relaxed);
-        read_count.fetch_add(is_read, std::memory_order_relaxed);
-    }
-    
-    void updateRate() noexcept {
-        uint64_t first = first_seen_ns.load(std::memory_order_relaxed);
-        uint64_t last = last_seen_ns.load(std::memory_order_relaxed);
-        uint64_t packets = packet_count.load(std::memory_order_relaxed);
-        
-        if (LIKELY(last > first)) {
-            uint64_t duration_ns = last - first;
-            uint64_t pps = (packets * 1000000000ULL) / duration_ns;
-            packets_per_second.store(static_cast<uint32_t>(pps), 
-                                    std::memory_order_relaxed);
-        }
+
+        const FcTraits& fc = fcTraits(pkt.function_code);
+        write_count.fetch_add(fc.isWrite(), std::memory_order_relaxed);
+        read_count.fetch_add(fc.isRead(), std::memory_order_relaxed);
     }
-    
+
     bool isDoS(uint32_t threshold) const noexcept {
-        return packets_per_second.load(std::memory_order_relaxed) > threshold;
+        // The in-progress window is a lower bound on the current rate, so
+        // a storm trips detection mid-second instead of one EWMA fold late
+        return packets_per_second.load(std::memory_order_relaxed) > threshold ||
+               window_count.load(std::memory_order_relaxed) > threshold;
     }
     
     double getWriteReadRatio() const noexcept {
@@ -108,8 +129,13 @@ private:
     };
     
     perf::FastHashMap<PortBitset, 4096> ip_ports_;
-    
+
 public:
+    // Aging sweep for the per-IP port bitsets (see FastHashMap::sweep)
+    size_t evictStale() noexcept {
+        return ip_ports_.sweep(2);
+    }
+
     bool checkPortScan(uint32_t ip, uint16_t port, uint32_t threshold) noexcept {
         auto* portset = ip_ports_.find(ip);
         
@@ -118,7 +144,7 @@ public:
             if (!portset) return false;
         }
         
-        auto now = std::chrono::steady_clock::now().time_since_epoch().count();
+        auto now = static_cast<int64_t>(perf::CoarseClock::steadyNs());
         uint64_t last = portset->last_reset_ns.load(std::memory_order_relaxed);
         
         if (now - last > 10000000000ULL) { // 10 seconds
@@ -131,96 +157,175 @@ public:
     }
 };
 
+// Register-protection index, compiled once from DetectionConfig ranges.
+// Fleet-wide (ANY_UNIT) ranges flatten into a 64KB severity-per-address
+// byte map - the common probe is a single indexed load, O(1) no matter
+// how many ranges operators configure. Unit-scoped ranges (rare) live in
+// a sorted interval array probed by binary search only when the packet's
+// unit id actually has overrides.
+class CriticalRegisterIndex {
+private:
+    // 0 = not critical, otherwise ThreatLevel + 1
+    std::array<uint8_t, 65536> any_unit_{};
+
+    struct UnitInterval {
+        uint32_t key_start;  // (unit_id << 16) | start
+        uint32_t key_end;    // (unit_id << 16) | end
+        ThreatLevel severity;
+    };
+    std::vector<UnitInterval> per_unit_;
+    std::array<bool, 256> unit_has_ranges_{};
+
+public:
+    void build(const std::vector<DetectionConfig::CriticalRegisterRange>& ranges) {
+        any_unit_.fill(0);
+        per_unit_.clear();
+        unit_has_ranges_.fill(false);
+
+        for (const auto& r : ranges) {
+            if (r.end < r.start) continue;
+
+            if (r.unit_id == DetectionConfig::ANY_UNIT) {
+                uint8_t sev = static_cast<uint8_t>(r.severity) + 1;
+                for (uint32_t a = r.start; a <= r.end; ++a) {
+                    any_unit_[a] = std::max(any_unit_[a], sev);
+                }
+            } else {
+                uint32_t base = static_cast<uint32_t>(r.unit_id) << 16;
+                per_unit_.push_back({base | r.start, base | r.end, r.severity});
+                unit_has_ranges_[r.unit_id] = true;
+            }
+        }
+
+        std::sort(per_unit_.begin(), per_unit_.end(),
+                  [](const UnitInterval& a, const UnitInterval& b) {
+                      return a.key_start < b.key_start;
+                  });
+    }
+
+    // HOT PATH: byte-map load; the interval search only runs for units
+    // that actually have scoped overrides
+    [[nodiscard]] std::optional<ThreatLevel> lookup(uint8_t unit_id,
+                                                    uint16_t address) const noexcept {
+        if (uint8_t sev = any_unit_[address]; sev != 0) {
+            return static_cast<ThreatLevel>(sev - 1);
+        }
+
+        if (UNLIKELY(unit_has_ranges_[unit_id])) {
+            uint32_t key = (static_cast<uint32_t>(unit_id) << 16) | address;
+            auto it = std::upper_bound(
+                per_unit_.begin(), per_unit_.end(), key,
+                [](uint32_t k, const UnitInterval& iv) {
+                    return k < iv.key_start;
+                });
+            if (it != per_unit_.begin()) {
+                --it;
+                if (key <= it->key_end) return it->severity;
+            }
+        }
+
+        return std::nullopt;
+    }
+};
+
 // Main behavioral analyzer
 class BehavioralAnalyzer {
 private:
     perf::FastHashMap<FastTrafficStats, 8192> ip_stats_;
     FastPortScanDetector port_scanner_;
-    DetectionConfig config_;
-    
+    CriticalRegisterIndex critical_registers_;
+
 public:
+    // Thresholds arrive per call via the caller's config snapshot (hot-
+    // reloadable); only the critical-register index is compiled here, so
+    // changing those ranges still requires a restart.
     explicit BehavioralAnalyzer(const DetectionConfig& config)
-        : config_(config) {}
+    {
+        critical_registers_.build(config.critical_registers);
+    }
     
-    // Analyze packet and return threats
-    std::vector<ThreatAlert> analyze(const PacketMetadata& pkt) noexcept {
-        std::vector<ThreatAlert> alerts;
-        
+    // One slot per detection rule - analyze() can never overflow this
+    static constexpr size_t MAX_ALERTS = 4;
+    using AlertBuffer = perf::StaticVector<ThreatAlert, MAX_ALERTS>;
+
+    // Analyze packet, writing threats into the caller-provided buffer
+    // (cleared first). Returns the alert count. The no-threat case -
+    // 99.99% of packets - touches no heap at all: the buffer is inline
+    // and alerts carry a message enum instead of a description string.
+    size_t analyze(const PacketMetadata& pkt, AlertBuffer& alerts,
+                   const DetectionConfig& cfg) noexcept {
+        alerts.clear();
+
         uint32_t src_ip = pkt.source_ip.to_uint32();
-        
+
         // Update stats
         auto* stats = ip_stats_.find(src_ip);
         if (!stats) {
             stats = ip_stats_.emplace(src_ip);
-            if (!stats) return alerts; // Map full
+            if (!stats) return 0; // Map full
         }
-        
+
         stats->update(pkt);
-        
+
         // Detection algorithms
-        
+
         // 1. DoS Detection
-        if (UNLIKELY(stats->isDoS(config_.dos_packet_threshold))) {
+        if (UNLIKELY(stats->isDoS(cfg.dos_packet_threshold))) {
             alerts.emplace_back(
                 pkt.source_ip, pkt.dest_ip,
                 AttackType::DOS_FLOOD,
                 ThreatLevel::CRITICAL,
-                "DoS flood detected",
                 0.95
             );
         }
-        
+
         // 2. Port Scan
-        if (UNLIKELY(port_scanner_.checkPortScan(src_ip, pkt.dest_port, 
-                                                 config_.port_scan_threshold))) {
+        if (UNLIKELY(port_scanner_.checkPortScan(src_ip, pkt.dest_port,
+                                                 cfg.port_scan_threshold))) {
             alerts.emplace_back(
                 pkt.source_ip, pkt.dest_ip,
                 AttackType::PORT_SCAN,
                 ThreatLevel::HIGH,
-                "Port scan detected",
                 0.90
             );
         }
-        
+
         // 3. Write/Read Ratio
         if (UNLIKELY((pkt.packet_size & 0xFF) == 0)) {
             double ratio = stats->getWriteReadRatio();
-            if (ratio > config_.write_read_ratio_threshold) {
+            if (ratio > cfg.write_read_ratio_threshold) {
                 alerts.emplace_back(
                     pkt.source_ip, pkt.dest_ip,
                     AttackType::ABNORMAL_TRAFFIC_PATTERN,
                     ThreatLevel::MEDIUM,
-                    "Abnormal write/read ratio",
                     0.75
                 );
             }
         }
-        
-        // 4. Unauthorized Write
-        if (pkt.protocol == ProtocolType::MODBUS_TCP && 
-            pkt.register_address < 100) {
-            uint8_t fc = static_cast<uint8_t>(pkt.function_code);
-            bool is_write = (fc == 0x05 || fc == 0x06 || fc == 0x0F || fc == 0x10);
-            
-            if (is_write) {
+
+        // 4. Unauthorized Write (configured critical register ranges;
+        //    IEC-104 information object addresses probe the same index)
+        if (pkt.protocol != ProtocolType::UNKNOWN &&
+            fcTraits(pkt.function_code).isWrite()) {
+            if (auto severity = critical_registers_.lookup(pkt.unit_id,
+                                                           pkt.register_address)) {
                 alerts.emplace_back(
                     pkt.source_ip, pkt.dest_ip,
                     AttackType::UNAUTHORIZED_WRITE,
-                    ThreatLevel::CRITICAL,
-                    "Unauthorized write to critical register",
+                    *severity,
                     0.90
                 );
             }
         }
-        
-        return alerts;
+
+        return alerts.size();
     }
     
-    // Periodic rate update (called from background thread)
-    void updateRates() noexcept {
-        // This is expensive, so do it periodically, not per-packet
-        // Implementation depends on how you want to iterate the hash map
-        // For now, rates are updated on-demand
+    // Aging sweep (called from GridWatcher::cleanupLoop): evicts IPs not
+    // seen for a couple of sweep periods so a spoofed-source flood cannot
+    // permanently exhaust the tracking tables and blind the detector.
+    size_t evictStale() noexcept {
+        return ip_stats_.sweep(2) + port_scanner_.evictStale();
     }
 };
 
@@ -0,0 +1,302 @@
+#pragma once
+
+// ============================================================================
+// Persistent blocklist journal - memory-mapped, append-only, binary.
+//
+// Every block/unblock event appends one fixed-size record to a pre-sized
+// mmap'd file; a restart replays the records straight out of the mapping
+// (no parsing, no text) so MitigationEngine recovers thousands of active
+// blocks in milliseconds instead of re-detecting each attacker one by one.
+//
+// Records carry the FULL resulting entry state (absolute expiry, violation
+// count), so replay reconstructs exactly what the table held - including
+// permanence earned through repeat violations - and the compacted form is
+// simply one record per live entry. Compaction runs in place when the
+// record area fills: latest-record-per-IP wins, unblocked/expired entries
+// drop out.
+//
+// Durability: appends only touch the mapping (no syscalls on the block
+// path); the cleanup thread calls flush() to msync, so a crash loses at
+// most one cleanup interval of events - acceptable for a blocklist that
+// re-detects stragglers anyway.
+//
+// POSIX mmap only: on other platforms the class compiles to a disabled
+// stub and the engine simply runs without persistence.
+// ============================================================================
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace gw::scada {
+
+class BlockJournal {
+public:
+    static constexpr uint32_t MAGIC = 0x4757424A;  // "GWBJ"
+    static constexpr uint32_t VERSION = 1;
+    static constexpr size_t CAPACITY_RECORDS = 65536;  // 2MB record area
+
+    enum class Op : uint8_t {
+        NONE = 0,
+        BLOCK = 1,    // entry state after a block/extend
+        UNBLOCK = 2
+    };
+
+    // Fixed 32-byte record: loaded straight from the mapping, never parsed
+    struct Record {
+        uint8_t op;
+        uint8_t reason;
+        uint16_t reserved;
+        uint32_t ip_key;
+        uint64_t blocked_at_ns;
+        uint64_t expires_at_ns;   // UINT64_MAX = permanent
+        uint32_t violation_count;
+        uint32_t reserved2;
+    };
+    static_assert(sizeof(Record) == 32, "journal record must stay fixed-size");
+
+private:
+    struct Header {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t committed;   // records valid in the area below
+        uint64_t reserved[2];
+    };
+    static_assert(sizeof(Header) == 32);
+
+    static constexpr size_t FILE_SIZE =
+        sizeof(Header) + CAPACITY_RECORDS * sizeof(Record);
+
+#ifndef _WIN32
+    int fd_{-1};
+    uint8_t* map_{nullptr};
+
+    Header* header() noexcept {
+        return reinterpret_cast<Header*>(map_);
+    }
+    Record* records() noexcept {
+        return reinterpret_cast<Record*>(map_ + sizeof(Header));
+    }
+
+    // Appends come from worker threads (auto-block during mitigation) and
+    // the API thread (manual block) - rare control-plane events, so a
+    // plain mutex matches the table's own per-shard writer locking
+    std::mutex write_mutex_;
+#endif
+
+public:
+    BlockJournal() = default;
+
+    ~BlockJournal() {
+        closeFile();
+    }
+
+    BlockJournal(const BlockJournal&) = delete;
+    BlockJournal& operator=(const BlockJournal&) = delete;
+
+#ifndef _WIN32
+    // Open (or create) the journal. Returns false on any file error - the
+    // engine then runs without persistence rather than refusing to start.
+    bool open(const std::string& path) noexcept {
+        closeFile();
+
+        fd_ = ::open(path.c_str(), O_RDWR | O_CREAT, 0600);
+        if (fd_ < 0) return false;
+
+        struct stat st{};
+        if (fstat(fd_, &st) < 0) {
+            closeFile();
+            return false;
+        }
+
+        bool fresh = (st.st_size == 0);
+        if (static_cast<size_t>(st.st_size) != FILE_SIZE) {
+            // New file, or a corrupt/resized one: re-initialize
+            if (ftruncate(fd_, static_cast<off_t>(FILE_SIZE)) < 0) {
+                closeFile();
+                return false;
+            }
+            fresh = fresh || (st.st_size != 0);
+        }
+
+        map_ = static_cast<uint8_t*>(
+            mmap(nullptr, FILE_SIZE, PROT_READ | PROT_WRITE,
+                 MAP_SHARED, fd_, 0));
+        if (map_ == MAP_FAILED) {
+            map_ = nullptr;
+            closeFile();
+            return false;
+        }
+
+        if (fresh || header()->magic != MAGIC ||
+            header()->version != VERSION ||
+            header()->committed > CAPACITY_RECORDS) {
+            // Unknown contents: start a clean journal rather than replay
+            // garbage into the block table
+            header()->magic = MAGIC;
+            header()->version = VERSION;
+            std::atomic_ref<uint64_t>(header()->committed).store(0);
+        }
+
+        return true;
+    }
+
+    [[nodiscard]] bool isOpen() const noexcept { return map_ != nullptr; }
+
+    // Append the resulting state of a block/extend. Record first, commit
+    // counter last: a crash mid-append leaves the counter pointing at the
+    // previous fully-written record.
+    void recordBlock(uint32_t ip_key, uint8_t reason,
+                     uint64_t blocked_at_ns, uint64_t expires_at_ns,
+                     uint32_t violation_count) noexcept {
+        if (!map_) return;
+
+        Record rec{};
+        rec.op = static_cast<uint8_t>(Op::BLOCK);
+        rec.reason = reason;
+        rec.ip_key = ip_key;
+        rec.blocked_at_ns = blocked_at_ns;
+        rec.expires_at_ns = expires_at_ns;
+        rec.violation_count = violation_count;
+
+        append(rec);
+    }
+
+    void recordUnblock(uint32_t ip_key, uint64_t now_ns) noexcept {
+        if (!map_) return;
+
+        Record rec{};
+        rec.op = static_cast<uint8_t>(Op::UNBLOCK);
+        rec.ip_key = ip_key;
+        rec.blocked_at_ns = now_ns;
+
+        append(rec);
+    }
+
+    // Replay committed records in order. fn(const Record&) applies each
+    // event; the caller decides what "live" means (expiry vs now).
+    template<typename Fn>
+    size_t replay(Fn&& fn) noexcept {
+        if (!map_) return 0;
+
+        uint64_t committed =
+            std::atomic_ref<uint64_t>(header()->committed).load();
+        Record* recs = records();
+
+        for (uint64_t i = 0; i < committed; ++i) {
+            fn(static_cast<const Record&>(recs[i]));
+        }
+        return static_cast<size_t>(committed);
+    }
+
+    // Sync the mapping to disk. Called by the cleanup thread - never from
+    // the block path.
+    void flush() noexcept {
+        if (!map_) return;
+        msync(map_, FILE_SIZE, MS_SYNC);
+    }
+
+    // Drop history the table no longer needs: keep the latest record per
+    // IP, discard unblocks and entries already expired at now_ns. Runs in
+    // place under the writer mutex (readers only exist at startup).
+    void compact(uint64_t now_ns) noexcept {
+        if (!map_) return;
+
+        std::lock_guard lock(write_mutex_);
+        compactLocked(now_ns);
+    }
+
+    [[nodiscard]] size_t committedRecords() noexcept {
+        if (!map_) return 0;
+        return static_cast<size_t>(
+            std::atomic_ref<uint64_t>(header()->committed).load());
+    }
+
+    [[nodiscard]] static constexpr size_t capacity() noexcept {
+        return CAPACITY_RECORDS;
+    }
+
+private:
+    void append(const Record& rec) noexcept {
+        std::lock_guard lock(write_mutex_);
+
+        std::atomic_ref<uint64_t> committed(header()->committed);
+        uint64_t slot = committed.load();
+
+        if (slot >= CAPACITY_RECORDS) {
+            // Full: fold history down to live state, then retry
+            compactLocked(rec.blocked_at_ns);
+            slot = committed.load();
+            if (slot >= CAPACITY_RECORDS) return; // >64K live blocks: drop
+        }
+
+        records()[slot] = rec;
+        committed.store(slot + 1, std::memory_order_release);
+    }
+
+    void compactLocked(uint64_t now_ns) noexcept {
+        std::atomic_ref<uint64_t> committed(header()->committed);
+        uint64_t count = committed.load();
+        Record* recs = records();
+
+        // Latest record per IP wins; unblocked and expired entries drop
+        std::unordered_map<uint32_t, Record> live;
+        live.reserve(1024);
+
+        for (uint64_t i = 0; i < count; ++i) {
+            const Record& rec = recs[i];
+            if (rec.op == static_cast<uint8_t>(Op::UNBLOCK)) {
+                live.erase(rec.ip_key);
+            } else if (rec.op == static_cast<uint8_t>(Op::BLOCK) &&
+                       rec.expires_at_ns > now_ns) {
+                live[rec.ip_key] = rec;
+            }
+        }
+
+        uint64_t out = 0;
+        for (const auto& [key, rec] : live) {
+            recs[out++] = rec;
+        }
+        committed.store(out, std::memory_order_release);
+    }
+
+    void closeFile() noexcept {
+        if (map_) {
+            msync(map_, FILE_SIZE, MS_SYNC);
+            munmap(map_, FILE_SIZE);
+            map_ = nullptr;
+        }
+        if (fd_ >= 0) {
+            ::close(fd_);
+            fd_ = -1;
+        }
+    }
+
+#else
+    // Windows stub: engine runs without persistence
+    bool open(const std::string&) noexcept { return false; }
+    [[nodiscard]] bool isOpen() const noexcept { return false; }
+    void recordBlock(uint32_t, uint8_t, uint64_t, uint64_t, uint32_t) noexcept {}
+    void recordUnblock(uint32_t, uint64_t) noexcept {}
+    template<typename Fn> size_t replay(Fn&&) noexcept { return 0; }
+    void flush() noexcept {}
+    void compact(uint64_t) noexcept {}
+    [[nodiscard]] size_t committedRecords() noexcept { return 0; }
+    [[nodiscard]] static constexpr size_t capacity() noexcept { return 0; }
+
+private:
+    void closeFile() noexcept {}
+#endif
+};
+
+} // namespace gw::scada
@@ -1,6 +1,9 @@
 #pragma once
 
 #include "../core/ipv4.hpp"
+#include "types.hpp"
+#include <atomic>
+#include <memory>
 #include <vector>
 #include <chrono>
 
@@ -18,15 +21,44 @@ namespace gw::scada {
         uint32_t dos_packet_threshold = 1000;
         uint64_t dos_byte_threshold = 10'000'000;
         std::chrono::seconds dos_window{5};
+        // Token-bucket depth for the per-IP rate limiter. Sized above the
+        // sustained rate so legitimate SCADA polling bursts pass through.
+        uint32_t dos_burst_size = 2000;
         
         // Behavioral anomaly
         double write_read_ratio_threshold = 5.0;
         uint32_t exception_rate_threshold = 10;
         double packet_size_deviation_threshold = 3.0;
+
+        // Critical register protection: writes into these [start,end]
+        // address ranges raise UNAUTHORIZED_WRITE at the given severity.
+        // unit_id scopes a range to one device; ANY_UNIT applies it fleet-
+        // wide. Compiled into a flat index at analyzer construction, so
+        // lookup cost does not grow with the number of ranges.
+        static constexpr uint8_t ANY_UNIT = 0xFF;
+
+        struct CriticalRegisterRange {
+            uint16_t start;
+            uint16_t end;                    // inclusive
+            uint8_t unit_id = ANY_UNIT;
+            ThreatLevel severity = ThreatLevel::CRITICAL;
+        };
+
+        std::vector<CriticalRegisterRange> critical_registers{
+            {0, 99, ANY_UNIT, ThreatLevel::CRITICAL}  // historical default
+        };
         
         // Network lists
         std::vector<net::ipv4> whitelisted_ips;
         std::vector<net::ipv4> blacklisted_ips;
+
+        // Whitelisted CIDR prefixes (host addresses belong in
+        // whitelisted_ips; ranges go here and are matched via LPM)
+        struct Cidr {
+            net::ipv4 address;
+            uint8_t prefix_length = 32;
+        };
+        std::vector<Cidr> whitelisted_subnets;
         std::vector<uint16_t> monitored_ports{502, 20000};
         
         // Auto-mitigation
@@ -38,6 +70,19 @@ namespace gw::scada {
         size_t packet_buffer_size = 4096;
         size_t log_queue_size = 8192;
         uint32_t worker_threads = 4;
+        // How many empty-queue polls a worker spins before parking on the
+        // wakeup condition variable. Higher = lower latency under bursty
+        // load, lower = less idle CPU (matters on fanless substation boxes).
+        uint32_t worker_spin_iterations = 4000;
+
+        // Path to the mmap'd blocklist journal. Non-empty = blocks survive
+        // restarts (replayed into the block table at startup); empty =
+        // persistence disabled.
+        std::string blocklist_journal_path;
+
+        // Path to the mmap'd binary threat-alert journal (circular,
+        // size-capped). Empty = alerts go to the text logger only.
+        std::string alert_journal_path;
         
         // Validation
         [[nodiscard]] bool isValid() const noexcept {
@@ -71,4 +116,37 @@ namespace gw::scada {
         }
     };
 
+    // ========================================================================
+    // RCU-style published config (hot reload without restart)
+    // ========================================================================
+    // One authoritative immutable snapshot behind an atomic shared_ptr
+    // swap - the same publish pattern as the Prometheus exporter's scrape
+    // buffer. Readers load the pointer once per packet (or batch) and see
+    // a fully consistent config; a reload builds a fresh copy and swaps it
+    // in, and the old snapshot stays alive until the last in-flight reader
+    // drops its reference. Workers are never stalled: no locks on the read
+    // side, and a threshold change takes effect on the very next snapshot
+    // load.
+    class ConfigStore {
+    private:
+        std::atomic<std::shared_ptr<const DetectionConfig>> current_;
+
+    public:
+        explicit ConfigStore(const DetectionConfig& initial)
+            : current_(std::make_shared<const DetectionConfig>(initial)) {}
+
+        ConfigStore(const ConfigStore&) = delete;
+        ConfigStore& operator=(const ConfigStore&) = delete;
+
+        [[nodiscard]] std::shared_ptr<const DetectionConfig>
+        snapshot() const noexcept {
+            return current_.load(std::memory_order_acquire);
+        }
+
+        void publish(const DetectionConfig& next) {
+            current_.store(std::make_shared<const DetectionConfig>(next),
+                           std::memory_order_release);
+        }
+    };
+
 } // namespace gw::scada
@@ -0,0 +1,152 @@
+#pragma once
+
+#include "types.hpp"
+#include <span>
+#include <optional>
+#include <cstring>
+
+namespace gw::scada {
+
+    // DNP3 Link Layer Header (10 bytes, IEEE 1815)
+    struct DNP3LinkHeader {
+        uint8_t start1;      // 0x05
+        uint8_t start2;      // 0x64
+        uint8_t length;      // Bytes after length field, excluding CRCs (5..255)
+        uint8_t control;     // DIR/PRM/FCB/FCV + link function code
+        uint16_t destination;
+        uint16_t source;
+        // CRC(2) follows on the wire
+
+        static constexpr size_t SIZE = 8;        // struct bytes
+        static constexpr size_t WIRE_SIZE = 10;  // + header CRC
+        static constexpr uint8_t START1 = 0x05;
+        static constexpr uint8_t START2 = 0x64;
+
+        bool isValid() const noexcept {
+            return start1 == START1 && start2 == START2 && length >= 5;
+        }
+
+        // DIR bit: 1 = from master, 0 = from outstation
+        bool fromMaster() const noexcept { return (control & 0x80) != 0; }
+    } __attribute__((packed));
+
+    // DNP3 Application Layer function codes (subset yang relevan untuk deteksi)
+    enum class DNP3FunctionCode : uint8_t {
+        CONFIRM = 0x00,
+        READ = 0x01,
+        WRITE = 0x02,
+        SELECT = 0x03,
+        OPERATE = 0x04,
+        DIRECT_OPERATE = 0x05,
+        DIRECT_OPERATE_NR = 0x06,
+        COLD_RESTART = 0x0D,
+        WARM_RESTART = 0x0E,
+        RESPONSE = 0x81,
+        UNSOLICITED_RESPONSE = 0x82
+    };
+
+    // DNP3 Parser Class - mengikuti pola ModbusParser (span-based, noexcept,
+    // zero-allocation). Metadata di-map ke field PacketMetadata yang sudah
+    // ada supaya behavioral analyzer langsung bisa menghitung read/write
+    // ratio tanpa tahu protokolnya.
+    class DNP3Parser {
+    private:
+        // Link header + its CRC (link-only frames are valid DNP3)
+        static constexpr size_t MIN_PACKET_SIZE = DNP3LinkHeader::WIRE_SIZE;
+        static constexpr size_t MAX_PACKET_SIZE = 292;  // Max link frame size
+
+        // Offsets into the first user data block (after header + its CRC)
+        static constexpr size_t TRANSPORT_OFFSET = DNP3LinkHeader::WIRE_SIZE;
+        static constexpr size_t APP_CTRL_OFFSET = TRANSPORT_OFFSET + 1;
+        static constexpr size_t APP_FC_OFFSET = TRANSPORT_OFFSET + 2;
+        static constexpr size_t IIN_OFFSET = TRANSPORT_OFFSET + 3;
+
+    public:
+        // Parse DNP3 link frame
+        static std::optional<PacketMetadata> parse(std::span<const std::byte> data) noexcept {
+            if (data.size() < MIN_PACKET_SIZE || data.size() > MAX_PACKET_SIZE) {
+                return std::nullopt;
+            }
+
+            PacketMetadata meta;
+            meta.protocol = ProtocolType::DNP3;
+            meta.packet_size = data.size();
+
+            DNP3LinkHeader header;
+            std::memcpy(&header, data.data(), DNP3LinkHeader::SIZE);
+
+            if (!header.isValid()) {
+                meta.is_malformed = true;
+                return meta;
+            }
+
+            // DNP3 addresses are little-endian on the wire
+            meta.unit_id = static_cast<uint8_t>(header.destination & 0xFF);
+            meta.is_response = !header.fromMaster();
+
+            // Link-only frames (ACK, link status, reset) carry no app layer
+            if (data.size() < APP_FC_OFFSET + 1) {
+                return meta;
+            }
+
+            // Application header lives in the first user data block, after
+            // the transport octet. App sequence doubles as transaction id
+            // so request/response pairing works like Modbus.
+            uint8_t app_ctrl = static_cast<uint8_t>(data[APP_CTRL_OFFSET]);
+            uint8_t app_fc = static_cast<uint8_t>(data[APP_FC_OFFSET]);
+            meta.transaction_id = app_ctrl & 0x0F;  // SEQ
+
+            auto fc = static_cast<DNP3FunctionCode>(app_fc);
+            meta.function_code = toCanonicalFc(fc);
+            meta.is_response = (fc == DNP3FunctionCode::RESPONSE ||
+                                fc == DNP3FunctionCode::UNSOLICITED_RESPONSE);
+
+            // Responses carry Internal Indications; error bits become the
+            // protocol-neutral "exception" signal the analyzer already tracks
+            if (meta.is_response && data.size() >= IIN_OFFSET + 2) {
+                uint8_t iin1 = static_cast<uint8_t>(data[IIN_OFFSET]);
+                uint8_t iin2 = static_cast<uint8_t>(data[IIN_OFFSET + 1]);
+                // IIN1.6 device trouble; IIN2.0-2.3 no-func/unknown-object/
+                // parameter-error/buffer-overflow
+                meta.has_exception = (iin1 & 0x40) != 0 || (iin2 & 0x0F) != 0;
+            }
+
+            return meta;
+        }
+
+    private:
+        // Map DNP3 app functions onto the canonical read/write buckets used
+        // by TrafficStats - control operations are "writes", polls "reads"
+        static ModbusFunctionCode toCanonicalFc(DNP3FunctionCode fc) noexcept {
+            switch (fc) {
+                case DNP3FunctionCode::READ:
+                case DNP3FunctionCode::RESPONSE:
+                case DNP3FunctionCode::UNSOLICITED_RESPONSE:
+                    return ModbusFunctionCode::READ_HOLDING_REGISTERS;
+
+                case DNP3FunctionCode::WRITE:
+                case DNP3FunctionCode::SELECT:
+                case DNP3FunctionCode::OPERATE:
+                case DNP3FunctionCode::DIRECT_OPERATE:
+                case DNP3FunctionCode::DIRECT_OPERATE_NR:
+                case DNP3FunctionCode::COLD_RESTART:
+                case DNP3FunctionCode::WARM_RESTART:
+                    return ModbusFunctionCode::WRITE_SINGLE_REGISTER;
+
+                default:
+                    return static_cast<ModbusFunctionCode>(0);
+            }
+        }
+    };
+
+    // Quick validation without full parsing (pola isModbusTCP)
+    inline bool isDNP3(std::span<const std::byte> data) noexcept {
+        if (data.size() < DNP3LinkHeader::WIRE_SIZE) {
+            return false;
+        }
+
+        return data[0] == std::byte{DNP3LinkHeader::START1} &&
+               data[1] == std::byte{DNP3LinkHeader::START2};
+    }
+
+} // namespace gw::scada
@@ -0,0 +1,156 @@
+#pragma once
+
+#include "types.hpp"
+#include <span>
+#include <optional>
+
+namespace gw::scada {
+
+    // IEC 60870-5-104 APCI Header (6 bytes)
+    struct IEC104Header {
+        static constexpr size_t SIZE = 6;
+        static constexpr uint8_t START = 0x68;
+        static constexpr size_t MAX_APDU = 253;  // Length field max
+
+        enum class Format : uint8_t {
+            I_FORMAT,  // Information transfer (carries ASDU)
+            S_FORMAT,  // Supervisory (ack only)
+            U_FORMAT   // Unnumbered control (STARTDT/STOPDT/TESTFR)
+        };
+    };
+
+    // ASDU Type IDs yang relevan (IEC 60870-5-101 companion standard)
+    // 1..44  = monitor direction (process data dari outstation)
+    // 45..69 = control direction (perintah dari master)
+    // 100+   = system commands (interrogation, clock sync, ...)
+    enum class IEC104TypeId : uint8_t {
+        M_SP_NA_1 = 1,    // Single-point information
+        M_ME_NA_1 = 9,    // Measured value, normalized
+        C_SC_NA_1 = 45,   // Single command
+        C_DC_NA_1 = 46,   // Double command
+        C_SE_NA_1 = 48,   // Set-point command
+        C_IC_NA_1 = 100,  // Interrogation command
+        C_CS_NA_1 = 103   // Clock synchronization
+    };
+
+    // IEC-104 Parser Class - pola sama dengan ModbusParser/DNP3Parser:
+    // span-based, noexcept, zero-allocation, hasil di-map ke PacketMetadata.
+    class IEC104Parser {
+    private:
+        static constexpr size_t MIN_PACKET_SIZE = IEC104Header::SIZE;
+        static constexpr size_t MAX_PACKET_SIZE = IEC104Header::MAX_APDU + 2;
+
+        // I-format ASDU layout (offsets dari awal APDU)
+        static constexpr size_t TYPE_ID_OFFSET = 6;
+        static constexpr size_t VSQ_OFFSET = 7;
+        static constexpr size_t COT_OFFSET = 8;     // 2 bytes
+        static constexpr size_t ADDR_OFFSET = 10;   // Common address, 2 bytes
+        static constexpr size_t IOA_OFFSET = 12;    // First IOA, 3 bytes
+
+    public:
+        // Parse IEC-104 APDU
+        static std::optional<PacketMetadata> parse(std::span<const std::byte> data) noexcept {
+            if (data.size() < MIN_PACKET_SIZE || data.size() > MAX_PACKET_SIZE) {
+                return std::nullopt;
+            }
+
+            PacketMetadata meta;
+            meta.protocol = ProtocolType::IEC_104;
+            meta.packet_size = data.size();
+
+            if (data[0] != std::byte{IEC104Header::START}) {
+                meta.is_malformed = true;
+                return meta;
+            }
+
+            // Length field = APDU bytes after itself; must match the frame
+            size_t apdu_len = static_cast<size_t>(data[1]);
+            if (apdu_len < 4 || apdu_len + 2 > data.size()) {
+                meta.is_malformed = true;
+                return meta;
+            }
+
+            uint8_t ctrl1 = static_cast<uint8_t>(data[2]);
+
+            // Frame format dari 2 bit terendah control field pertama
+            if ((ctrl1 & 0x01) == 0) {
+                // I-format: send sequence di ctrl1/2, ASDU menyusul
+                meta.transaction_id =
+                    static_cast<uint16_t>((ctrl1 >> 1) |
+                                          (static_cast<uint8_t>(data[3]) << 7));
+                return parseAsdu(data, meta);
+            }
+
+            if ((ctrl1 & 0x03) == 0x01) {
+                // S-format: pure acknowledgement
+                meta.is_response = true;
+                return meta;
+            }
+
+            // U-format: STARTDT/STOPDT/TESTFR; con bits menandakan jawaban
+            meta.is_response = (ctrl1 & 0x8A) != 0;  // any *con bit
+            return meta;
+        }
+
+    private:
+        static std::optional<PacketMetadata> parseAsdu(
+            std::span<const std::byte> data, PacketMetadata& meta) noexcept
+        {
+            // ASDU minimal: type(1) + VSQ(1) + COT(2) + common addr(2)
+            if (data.size() < ADDR_OFFSET + 2) {
+                meta.is_malformed = true;
+                return meta;
+            }
+
+            uint8_t type_id = static_cast<uint8_t>(data[TYPE_ID_OFFSET]);
+            uint8_t vsq = static_cast<uint8_t>(data[VSQ_OFFSET]);
+            uint8_t cot = static_cast<uint8_t>(data[COT_OFFSET]);
+
+            meta.unit_id = static_cast<uint8_t>(data[ADDR_OFFSET]);  // low byte
+            meta.register_count = vsq & 0x7F;  // number of objects
+
+            // Monitor direction (1..44) = data dari outstation = response;
+            // control direction (45+) = perintah master = request/write
+            meta.is_response = (type_id >= 1 && type_id <= 44);
+            meta.function_code = toCanonicalFc(type_id);
+
+            // P/N bit set = negative confirmation; COT 44..47 = unknown
+            // type/cause/address - keduanya exception bagi analyzer
+            uint8_t cause = cot & 0x3F;
+            meta.has_exception = (cot & 0x40) != 0 ||
+                                 (cause >= 44 && cause <= 47);
+
+            // First Information Object Address: low 16 bit masuk ke
+            // register_address supaya critical-range check ikut bekerja
+            if (data.size() >= IOA_OFFSET + 3) {
+                meta.register_address = static_cast<uint16_t>(
+                    static_cast<uint8_t>(data[IOA_OFFSET]) |
+                    (static_cast<uint8_t>(data[IOA_OFFSET + 1]) << 8));
+            }
+
+            return meta;
+        }
+
+        // Commands (control direction) = write bucket, data/polls = read
+        static ModbusFunctionCode toCanonicalFc(uint8_t type_id) noexcept {
+            if (type_id >= 45 && type_id <= 69) {
+                return ModbusFunctionCode::WRITE_SINGLE_REGISTER;
+            }
+            if ((type_id >= 1 && type_id <= 44) || type_id >= 100) {
+                return ModbusFunctionCode::READ_HOLDING_REGISTERS;
+            }
+            return static_cast<ModbusFunctionCode>(0);
+        }
+    };
+
+    // Quick validation without full parsing
+    inline bool isIEC104(std::span<const std::byte> data) noexcept {
+        if (data.size() < IEC104Header::SIZE) {
+            return false;
+        }
+
+        return data[0] == std::byte{IEC104Header::START} &&
+               static_cast<size_t>(data[1]) >= 4;
+    }
+
+} // namespace gw::scada
@@ -2,9 +2,14 @@
 
 #include "types.hpp"
 #include "config.hpp"
-#include <unordered_map>
+#include "block_journal.hpp"
+#include "../performance/sharded_block_table.hpp"
+#include "../performance/lpm_table.hpp"
 #include <unordered_set>
 #include <vector>
+#include <array>
+#include <atomic>
+#include <algorithm>
 #include <mutex>
 #include <shared_mutex>
 #include <chrono>
@@ -33,6 +38,17 @@ namespace gw::scada {
         QUARANTINE = 6
     };
 
+    // Outcome of mitigate(): the action plus whether a BLOCK_IP created a
+    // new block-table entry (vs extending one already present). Callers
+    // maintaining derived caches keyed on block lifetime - the counting
+    // bloom cache in particular - must count only the fresh transition,
+    // because removal fires exactly once per entry (expiry sweep or manual
+    // unblock) and repeated adds would saturate the 4-bit counters sticky.
+    struct MitigationResult {
+        MitigationAction action;
+        bool fresh_block;
+    };
+
     // Blocked IP entry
     struct BlockedIP {
         using TimePoint = std::chrono::system_clock::time_point;
@@ -77,69 +93,175 @@ namespace gw::scada {
         }
     };
 
-    // Rate limiter per IP
+    // Per-IP token-bucket rate limiter (lock-free).
+    //
+    // Each tracked IP owns one 64-bit word packing {last_refill_ms, tokens};
+    // refill and consume are a single CAS on that word, so shouldBlock() -
+    // which sits on the hot path of every non-whitelisted packet - never
+    // takes a lock. Buckets live in a fixed-capacity open-addressed table
+    // with atomic keys (same zero-allocation design as FastHashMap).
     class RateLimiter {
     private:
-        struct RateInfo {
-            using TimePoint = std::chrono::system_clock::time_point;
-            uint32_t packet_count;
-            TimePoint window_start;
+        static constexpr size_t CAPACITY = 8192;
+        static constexpr size_t MAX_PROBE = 32;
+
+        struct Bucket {
+            std::atomic<uint32_t> key{0};    // 0 = empty slot
+            std::atomic<uint64_t> state{0};  // high 32: last refill tick (ms),
+                                             // low 32: available tokens
         };
-        
-        std::unordered_map<uint32_t, RateInfo> ip_rates_;
-        mutable std::shared_mutex mutex_;
-        
-        uint32_t max_packets_per_second_;
-        
+
+        std::array<Bucket, CAPACITY> buckets_;
+
+        // Relaxed atomics so a config reload can retune limits while
+        // workers are mid-shouldBlock; each call reads a coherent pair at
+        // worst one packet late
+        std::atomic<uint32_t> max_packets_per_second_;
+        std::atomic<uint32_t> burst_size_;
+
+        static constexpr uint32_t hash(uint32_t key) noexcept {
+            key ^= key >> 16;
+            key *= 0x85ebca6b;
+            key ^= key >> 13;
+            key *= 0xc2b2ae35;
+            key ^= key >> 16;
+            return key % CAPACITY;
+        }
+
+        // Milliseconds since steady epoch, truncated to 32 bits. Wraps every
+        // ~49 days; elapsed-time math below is wraparound-safe.
+        static uint32_t tickMs() noexcept {
+            return static_cast<uint32_t>(
+                std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::steady_clock::now().time_since_epoch()
+                ).count()
+            );
+        }
+
+        static constexpr uint64_t pack(uint32_t tick, uint32_t tokens) noexcept {
+            return (static_cast<uint64_t>(tick) << 32) | tokens;
+        }
+
+        Bucket* findOrCreate(uint32_t ip_key, uint32_t now_ms) noexcept {
+            uint32_t idx = hash(ip_key);
+
+            for (size_t probe = 0; probe < MAX_PROBE; ++probe) {
+                Bucket& b = buckets_[(idx + probe) % CAPACITY];
+                uint32_t k = b.key.load(std::memory_order_acquire);
+
+                if (k == ip_key) return &b;
+
+                if (k == 0) {
+                    // Claim the slot: publish a full bucket first, key last
+                    b.state.store(
+                        pack(now_ms,
+                             burst_size_.load(std::memory_order_relaxed)),
+                        std::memory_order_relaxed);
+                    uint32_t expected = 0;
+                    if (b.key.compare_exchange_strong(expected, ip_key,
+                            std::memory_order_acq_rel)) {
+                        return &b;
+                    }
+                    if (expected == ip_key) return &b; // lost race to ourselves
+                }
+            }
+
+            return nullptr; // probe window full
+        }
+
     public:
-        explicit RateLimiter(uint32_t max_pps) 
-            : max_packets_per_second_(max_pps) 
+        RateLimiter(uint32_t max_pps, uint32_t burst_size) noexcept
+            : max_packets_per_second_(max_pps)
+            , burst_size_(burst_size > 0 ? burst_size : max_pps)
         {}
-        
-        bool shouldBlock(const net::ipv4& ip) {
-            std::unique_lock lock(mutex_);
-            
-            uint32_t ip_key = ip.to_uint32();
-            auto now = std::chrono::system_clock::now();
-            auto& info = ip_rates_[ip_key];
-            
-            // Reset window if expired
-            auto window_duration = std::chrono::duration_cast<std::chrono::seconds>(
-                now - info.window_start
-            );
-            
-            if (window_duration.count() >= 1) {
-                info.packet_count = 0;
-                info.window_start = now;
+
+        // HOT PATH: refill + consume one token with a single CAS.
+        // Returns true if the IP exceeded its rate and should be blocked.
+        bool shouldBlock(const net::ipv4& ip) noexcept {
+            uint32_t now_ms = tickMs();
+            Bucket* bucket = findOrCreate(ip.to_uint32(), now_ms);
+            if (UNLIKELY(!bucket)) return false; // table full - fail open
+
+            uint64_t current = bucket->state.load(std::memory_order_relaxed);
+
+            for (;;) {
+                uint32_t last_ms = static_cast<uint32_t>(current >> 32);
+                uint32_t tokens = static_cast<uint32_t>(current);
+
+                uint32_t elapsed_ms = now_ms - last_ms; // wraparound-safe
+                uint64_t refill =
+                    (static_cast<uint64_t>(elapsed_ms) *
+                     max_packets_per_second_.load(std::memory_order_relaxed))
+                    / 1000;
+
+                uint64_t available = std::min<uint64_t>(
+                    tokens + refill,
+                    burst_size_.load(std::memory_order_relaxed));
+
+                if (available == 0) {
+                    return true; // bucket empty - rate exceeded (no CAS needed)
+                }
+
+                // Only advance the tick when we actually minted tokens, so
+                // sub-millisecond refills are not rounded away
+                uint32_t new_tick = (refill > 0) ? now_ms : last_ms;
+                uint64_t desired = pack(new_tick,
+                                        static_cast<uint32_t>(available - 1));
+
+                if (bucket->state.compare_exchange_weak(current, desired,
+                        std::memory_order_relaxed)) {
+                    return false;
+                }
             }
-            
-            info.packet_count++;
-            
-            return info.packet_count > max_packets_per_second_;
         }
-        
-        void reset(const net::ipv4& ip) {
-            std::unique_lock lock(mutex_);
-            ip_rates_.erase(ip.to_uint32());
+
+        // Refill the bucket for an IP (e.g. after a manual unblock)
+        void reset(const net::ipv4& ip) noexcept {
+            uint32_t now_ms = tickMs();
+            if (Bucket* bucket = findOrCreate(ip.to_uint32(), now_ms)) {
+                bucket->state.store(
+                    pack(now_ms,
+                         burst_size_.load(std::memory_order_relaxed)),
+                    std::memory_order_relaxed);
+            }
         }
-        
-        void cleanup(std::chrono::seconds max_age) {
-            std::unique_lock lock(mutex_);
-            auto now = std::chrono::system_clock::now();
-            
-            for (auto it = ip_rates_.begin(); it != ip_rates_.end();) {
-                auto age = std::chrono::duration_cast<std::chrono::seconds>(
-                    now - it->second.window_start
-                );
-                if (age > max_age) {
-                    it = ip_rates_.erase(it);
-                } else {
-                    ++it;
+
+        // Retune on config reload. Existing buckets converge as they
+        // refill; no draining or rebuild needed.
+        void setLimits(uint32_t max_pps, uint32_t burst_size) noexcept {
+            max_packets_per_second_.store(max_pps,
+                                          std::memory_order_relaxed);
+            burst_size_.store(burst_size > 0 ? burst_size : max_pps,
+                              std::memory_order_relaxed);
+        }
+
+        // Reclaim buckets untouched for max_age so churning sources don't
+        // exhaust the table. A reclaimed slot simply gives its next occupant
+        // a fresh full bucket, so racing with the hot path is harmless.
+        void cleanup(std::chrono::seconds max_age) noexcept {
+            uint32_t now_ms = tickMs();
+            uint32_t max_age_ms = static_cast<uint32_t>(max_age.count() * 1000);
+
+            for (auto& b : buckets_) {
+                if (b.key.load(std::memory_order_relaxed) == 0) continue;
+
+                uint64_t state = b.state.load(std::memory_order_relaxed);
+                uint32_t last_ms = static_cast<uint32_t>(state >> 32);
+
+                if (now_ms - last_ms > max_age_ms) {
+                    b.key.store(0, std::memory_order_release);
                 }
             }
         }
     };
 
+    // A CIDR block rule (control-plane view)
+    struct BlockedSubnet {
+        net::ipv4 prefix;
+        uint8_t prefix_length;
+        AttackType reason;
+    };
+
     // Mitigation callback types
     using MitigationCallback = std::function<void(const ThreatAlert&, MitigationAction)>;
     using PacketFilterCallback = std::function<bool(const PacketMetadata&)>;
@@ -147,23 +269,34 @@ namespace gw::scada {
     // Main Mitigation Engine
     class MitigationEngine {
     private:
-        // Blocked IPs
-        std::unordered_map<uint32_t, BlockedIP> blocked_ips_;
-        mutable std::shared_mutex blocked_mutex_;
-        
+        // Blocked IPs (sharded table: lock-free lookups on the packet path,
+        // per-shard writer locks for the rare block/unblock/sweep events)
+        perf::ShardedBlockTable<16, 1024> blocked_ips_;
+
+        // After this many violations a block becomes permanent
+        static constexpr uint32_t PERMANENT_AFTER_VIOLATIONS = 5;
+
         // Whitelisted IPs (never block these)
         std::unordered_set<uint32_t> whitelisted_ips_;
         mutable std::shared_mutex whitelist_mutex_;
+
+        // CIDR rules: one /16 rule instead of thousands of /32 entries
+        // when a scanner walks a whole subnet. Lock-free LPM lookups on
+        // the packet path; value = AttackType for blocks.
+        perf::LpmTable<> blocked_subnets_;
+        perf::LpmTable<> whitelisted_subnets_;
         
         // Rate limiter
         RateLimiter rate_limiter_;
+
+        // Persistent block/unblock event journal (disabled when the config
+        // path is empty or the file cannot be opened)
+        BlockJournal journal_;
         
         // Callbacks for notifications
         std::vector<MitigationCallback> mitigation_callbacks_;
         std::mutex callback_mutex_;
-        
-        DetectionConfig config_;
-        
+
         // Statistics
         struct Stats {
             uint64_t total_blocks = 0;
@@ -175,29 +308,87 @@ namespace gw::scada {
         
     public:
         explicit MitigationEngine(const DetectionConfig& config)
-            : rate_limiter_(config.dos_packet_threshold)
-            , config_(config)
+            : rate_limiter_(config.dos_packet_threshold, config.dos_burst_size)
         {
-            // Initialize whitelist
+            // Initialize whitelist (host addresses and CIDR prefixes)
             for (const auto& ip : config.whitelisted_ips) {
                 addWhitelist(ip);
             }
+            for (const auto& cidr : config.whitelisted_subnets) {
+                addWhitelistSubnet(cidr.address, cidr.prefix_length);
+            }
+
+            if (!config.blocklist_journal_path.empty()) {
+                journal_.open(config.blocklist_journal_path);
+            }
+        }
+
+        // Replay the persisted journal into the block table (call once,
+        // right after construction, before traffic flows). on_restored
+        // fires with the ip_key of each block restored live so the caller
+        // can pre-warm derived caches. Returns the live block count.
+        template<typename Fn>
+        size_t restoreFromJournal(Fn&& on_restored) {
+            if (!journal_.isOpen()) return 0;
+
+            uint64_t now = nowNs();
+
+            journal_.replay([this, now](const BlockJournal::Record& rec) {
+                if (rec.op == static_cast<uint8_t>(BlockJournal::Op::UNBLOCK)) {
+                    blocked_ips_.erase(rec.ip_key, now);
+                } else if (rec.op == static_cast<uint8_t>(BlockJournal::Op::BLOCK)) {
+                    blocked_ips_.restore(rec.ip_key, rec.reason,
+                                         rec.blocked_at_ns, rec.expires_at_ns,
+                                         rec.violation_count, now);
+                }
+            });
+
+            // Drop anything that expired while we were down, then report
+            // the survivors
+            size_t live = blocked_ips_.sweep(now);
+            incrementStat([live](Stats& s) {
+                s.active_blocks = live;
+                s.total_blocks += live;
+            });
+
+            blocked_ips_.forEach(now, [&on_restored](const auto& entry) {
+                on_restored(entry.key);
+            });
+
+            return live;
         }
         
-        // Process threat alert and take action
-        MitigationAction mitigate(const ThreatAlert& alert) {
+        // Re-apply the hot-reloadable knobs from a fresh config snapshot.
+        // Whitelist deltas are the caller's job (GridWatcher diffs them so
+        // its bloom cache stays in sync with the engine's tables).
+        void applyConfig(const DetectionConfig& config) noexcept {
+            rate_limiter_.setLimits(config.dos_packet_threshold,
+                                    config.dos_burst_size);
+        }
+
+        // Process threat alert and take action. cfg is the caller's config
+        // snapshot (block duration is hot-reloadable).
+        MitigationResult mitigate(const ThreatAlert& alert,
+                                  const DetectionConfig& cfg) {
             // Check if IP is whitelisted
             if (isWhitelisted(alert.source_ip)) {
-                return MitigationAction::LOG_ONLY;
+                return {MitigationAction::LOG_ONLY, false};
             }
-            
+
             MitigationAction action = determineAction(alert);
-            
+            bool fresh_block = false;
+
             // Execute action
             switch (action) {
                 case MitigationAction::BLOCK_IP:
-                    blockIP(alert.source_ip, alert.attack_type, config_.auto_block_duration);
-                    incrementStat([](Stats& s) { s.total_blocks++; s.active_blocks++; });
+                    fresh_block = blockIP(alert.source_ip, alert.attack_type,
+                                          cfg.auto_block_duration);
+                    if (fresh_block) {
+                        incrementStat([](Stats& s) {
+                            s.total_blocks++;
+                            s.active_blocks++;
+                        });
+                    }
                     break;
                     
                 case MitigationAction::RATE_LIMIT:
@@ -214,12 +405,19 @@ namespace gw::scada {
             
             // Notify callbacks
             notifyCallbacks(alert, action);
-            
-            return action;
+
+            return {action, fresh_block};
         }
         
         // Check if packet should be dropped
         bool shouldDropPacket(const PacketMetadata& packet) {
+            // Whitelisted ranges bypass blocking and rate limiting (host
+            // whitelist is short-circuited earlier by GridWatcher's cache)
+            if (UNLIKELY(!whitelisted_subnets_.empty()) &&
+                whitelisted_subnets_.lookup(packet.source_ip.to_uint32())) {
+                return false;
+            }
+
             // Check if IP is blocked
             if (isBlocked(packet.source_ip)) {
                 incrementStat([](Stats& s) { s.total_packets_dropped++; });
@@ -235,46 +433,91 @@ namespace gw::scada {
             return false;
         }
         
-        // Manually block an IP
-        void blockIP(const net::ipv4& ip, AttackType reason, std::chrono::minutes duration) {
-            std::unique_lock lock(blocked_mutex_);
-            
-            uint32_t ip_key = ip.to_uint32();
-            
-            // Check if already blocked
-            auto it = blocked_ips_.find(ip_key);
-            if (it != blocked_ips_.end()) {
-                // Extend existing block
-                it->second.extend(duration);
-            } else {
-                // New block
-                if (blocked_ips_.size() >= config_.max_concurrent_blocks) {
-                    // Remove oldest non-permanent block
-                    removeOldestBlock();
-                }
-                
-                blocked_ips_.emplace(ip_key, BlockedIP(ip, reason, duration));
+        // Manually block an IP (extends the block if already present).
+        // Returns true only for a fresh block (new or previously reclaimed
+        // slot) - extending a block whose derived-cache bits are still set
+        // must not be counted by callers maintaining those caches.
+        bool blockIP(const net::ipv4& ip, AttackType reason, std::chrono::minutes duration) {
+            uint64_t duration_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                duration
+            ).count();
+
+            auto entry = blocked_ips_.blockOrExtend(
+                ip.to_uint32(),
+                static_cast<uint8_t>(reason),
+                nowNs(),
+                duration_ns,
+                PERMANENT_AFTER_VIOLATIONS
+            );
+
+            // Journal the resulting state (mmap write only - no syscall);
+            // replay reconstructs violations/permanence exactly
+            if (entry) {
+                journal_.recordBlock(entry->key, entry->reason,
+                                     entry->blocked_at_ns,
+                                     entry->expires_at_ns,
+                                     entry->violation_count);
             }
+
+            return entry && entry->fresh;
         }
-        
+
         // Unblock an IP
         bool unblockIP(const net::ipv4& ip) {
-            std::unique_lock lock(blocked_mutex_);
-            
-            auto erased = blocked_ips_.erase(ip.to_uint32());
-            if (erased > 0) {
+            uint64_t now = nowNs();
+            if (blocked_ips_.erase(ip.to_uint32(), now)) {
                 incrementStat([](Stats& s) { s.active_blocks--; });
                 rate_limiter_.reset(ip);
+                journal_.recordUnblock(ip.to_uint32(), now);
                 return true;
             }
             return false;
         }
-        
-        // Check if IP is blocked
-        bool isBlocked(const net::ipv4& ip) const {
-            std::shared_lock lock(blocked_mutex_);
-            auto it = blocked_ips_.find(ip.to_uint32());
-            return it != blocked_ips_.end() && !it->second.isExpired();
+
+        // Check if IP is blocked (HOT PATH - lock-free probes)
+        bool isBlocked(const net::ipv4& ip) const noexcept {
+            uint32_t key = ip.to_uint32();
+            if (blocked_ips_.contains(key, nowNs())) return true;
+            return UNLIKELY(!blocked_subnets_.empty()) &&
+                   blocked_subnets_.lookup(key).has_value();
+        }
+
+        // Subnet-only probe for GridWatcher's fast path (the /32 bloom
+        // cache cannot represent ranges)
+        bool isSubnetBlocked(const net::ipv4& ip) const noexcept {
+            return blocked_subnets_.lookup(ip.to_uint32()).has_value();
+        }
+
+        bool hasSubnetBlocks() const noexcept {
+            return !blocked_subnets_.empty();
+        }
+
+        // Block a whole CIDR range with one rule instead of accumulating
+        // per-host entries while a scanner walks the subnet
+        bool blockSubnet(const net::ipv4& prefix, uint8_t prefix_len,
+                         AttackType reason) {
+            if (blocked_subnets_.insert(prefix.to_uint32(), prefix_len,
+                                        static_cast<uint8_t>(reason))) {
+                incrementStat([](Stats& s) { s.total_blocks++; });
+                return true;
+            }
+            return false;
+        }
+
+        bool unblockSubnet(const net::ipv4& prefix, uint8_t prefix_len) {
+            return blocked_subnets_.remove(prefix.to_uint32(), prefix_len);
+        }
+
+        // Snapshot of active CIDR block rules
+        std::vector<BlockedSubnet> getBlockedSubnets() const {
+            std::vector<BlockedSubnet> result;
+            result.reserve(blocked_subnets_.size());
+            blocked_subnets_.forEach(
+                [&result](uint32_t prefix, uint8_t len, uint8_t value) {
+                    result.push_back({net::ipv4(prefix), len,
+                                      static_cast<AttackType>(value)});
+                });
+            return result;
         }
         
         // Whitelist management
@@ -289,20 +532,42 @@ namespace gw::scada {
         }
         
         bool isWhitelisted(const net::ipv4& ip) const {
+            uint32_t key = ip.to_uint32();
+            if (!whitelisted_subnets_.empty() &&
+                whitelisted_subnets_.lookup(key)) {
+                return true;
+            }
             std::shared_lock lock(whitelist_mutex_);
-            return whitelisted_ips_.count(ip.to_uint32()) > 0;
+            return whitelisted_ips_.count(key) > 0;
+        }
+
+        void addWhitelistSubnet(const net::ipv4& prefix, uint8_t prefix_len) {
+            whitelisted_subnets_.insert(prefix.to_uint32(), prefix_len, 1);
+        }
+
+        void removeWhitelistSubnet(const net::ipv4& prefix, uint8_t prefix_len) {
+            whitelisted_subnets_.remove(prefix.to_uint32(), prefix_len);
         }
         
         // Get list of blocked IPs
         std::vector<BlockedIP> getBlockedIPs() const {
-            std::shared_lock lock(blocked_mutex_);
             std::vector<BlockedIP> result;
-            result.reserve(blocked_ips_.size());
-            for (const auto& [_, blocked] : blocked_ips_) {
-                if (!blocked.isExpired()) {
-                    result.push_back(blocked);
-                }
-            }
+            result.reserve(blocked_ips_.activeCount());
+
+            blocked_ips_.forEach(nowNs(), [&result](const auto& entry) {
+                BlockedIP blocked;
+                blocked.ip = net::ipv4(entry.key);
+                blocked.blocked_at = fromNs(entry.blocked_at_ns);
+                blocked.reason = static_cast<AttackType>(entry.reason);
+                blocked.violation_count = entry.violation_count;
+                blocked.permanent =
+                    (entry.expires_at_ns == decltype(blocked_ips_)::PERMANENT_NS);
+                blocked.expires_at = blocked.permanent
+                    ? blocked.blocked_at + std::chrono::hours(24 * 365)
+                    : fromNs(entry.expires_at_ns);
+                result.push_back(blocked);
+            });
+
             return result;
         }
         
@@ -318,20 +583,31 @@ namespace gw::scada {
             return stats_;
         }
         
-        // Periodic cleanup of expired blocks
-        void cleanup() {
-            std::unique_lock lock(blocked_mutex_);
-            
-            for (auto it = blocked_ips_.begin(); it != blocked_ips_.end();) {
-                if (it->second.isExpired()) {
-                    it = blocked_ips_.erase(it);
-                    incrementStat([](Stats& s) { s.active_blocks--; });
-                } else {
-                    ++it;
+        // Periodic cleanup of expired blocks (sweeps shards independently,
+        // packet workers are never stalled). on_expired(ip_key) fires for
+        // each block reclaimed by this sweep so the caller can purge its
+        // derived caches.
+        template<typename Fn>
+        void cleanup(Fn&& on_expired) {
+            uint64_t now = nowNs();
+            size_t live = blocked_ips_.sweep(now, std::forward<Fn>(on_expired));
+            incrementStat([live](Stats& s) { s.active_blocks = live; });
+
+            rate_limiter_.cleanup(std::chrono::minutes(5));
+
+            // Persist journaled events off the hot path; fold history down
+            // once the record area is half full so appends never hit the
+            // full-journal compaction inline
+            if (journal_.isOpen()) {
+                if (journal_.committedRecords() > BlockJournal::capacity() / 2) {
+                    journal_.compact(now);
                 }
+                journal_.flush();
             }
-            
-            rate_limiter_.cleanup(std::chrono::minutes(5));
+        }
+
+        void cleanup() {
+            cleanup([](uint32_t) {});
         }
         
     private:
@@ -372,24 +648,27 @@ namespace gw::scada {
             }
         }
         
-        void removeOldestBlock() {
-            // Find oldest non-permanent block
-            auto oldest = blocked_ips_.end();
-            for (auto it = blocked_ips_.begin(); it != blocked_ips_.end(); ++it) {
-                if (!it->second.permanent) {
-                    if (oldest == blocked_ips_.end() || 
-                        it->second.blocked_at < oldest->second.blocked_at) {
-                        oldest = it;
-                    }
-                }
-            }
-            
-            if (oldest != blocked_ips_.end()) {
-                blocked_ips_.erase(oldest);
-                incrementStat([](Stats& s) { s.active_blocks--; });
-            }
+        // Time helpers (the block table stores system_clock ns since epoch)
+        static uint64_t nowNs() noexcept {
+            return toNs(std::chrono::system_clock::now());
         }
-        
+
+        static uint64_t toNs(std::chrono::system_clock::time_point tp) noexcept {
+            return static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    tp.time_since_epoch()
+                ).count()
+            );
+        }
+
+        static std::chrono::system_clock::time_point fromNs(uint64_t ns) noexcept {
+            return std::chrono::system_clock::time_point(
+                std::chrono::duration_cast<std::chrono::system_clock::duration>(
+                    std::chrono::nanoseconds(ns)
+                )
+            );
+        }
+
         template<typename Func>
         void incrementStat(Func&& func) {
             std::unique_lock lock(stats_mutex_);
@@ -4,6 +4,11 @@
 #include <span>
 #include <optional>
 #include <cstring>
+#include <algorithm>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
 
 namespace gw::scada {
 
@@ -101,50 +106,35 @@ namespace gw::scada {
         
     private:
         static void parseData(std::span<const std::byte> data, PacketMetadata& meta) noexcept {
-            try {
-                switch (meta.function_code) {
-                    case ModbusFunctionCode::READ_COILS:
-                    case ModbusFunctionCode::READ_DISCRETE_INPUTS:
-                    case ModbusFunctionCode::READ_HOLDING_REGISTERS:
-                    case ModbusFunctionCode::READ_INPUT_REGISTERS:
-                        if (data.size() >= 4) {
-                            // Read: Address(2) + Count(2)
-                            uint16_t addr, count;
-                            std::memcpy(&addr, data.data(), 2);
-                            std::memcpy(&count, data.data() + 2, 2);
-                            meta.register_address = ntohs(addr);
-                            meta.register_count = ntohs(count);
-                        }
-                        break;
-                        
-                    case ModbusFunctionCode::WRITE_SINGLE_COIL:
-                    case ModbusFunctionCode::WRITE_SINGLE_REGISTER:
-                        if (data.size() >= 2) {
-                            // Write single: Address(2) + Value(2)
-                            uint16_t addr;
-                            std::memcpy(&addr, data.data(), 2);
-                            meta.register_address = ntohs(addr);
-                            meta.register_count = 1;
-                        }
-                        break;
-                        
-                    case ModbusFunctionCode::WRITE_MULTIPLE_COILS:
-                    case ModbusFunctionCode::WRITE_MULTIPLE_REGISTERS:
-                        if (data.size() >= 5) {
-                            // Write multiple: Address(2) + Count(2) + ByteCount(1) + Values
-                            uint16_t addr, count;
-                            std::memcpy(&addr, data.data(), 2);
-                            std::memcpy(&count, data.data() + 2, 2);
-                            meta.register_address = ntohs(addr);
-                            meta.register_count = ntohs(count);
-                        }
-                        break;
-                        
-                    default:
-                        break;
+            // Classification and minimum length come from the shared
+            // FC_TRAITS table (data here excludes the function code byte)
+            const FcTraits& traits = fcTraits(meta.function_code);
+            if (data.size() + 1 < traits.min_pdu_length) {
+                return;
+            }
+
+            switch (meta.function_code) {
+                case ModbusFunctionCode::WRITE_SINGLE_COIL:
+                case ModbusFunctionCode::WRITE_SINGLE_REGISTER: {
+                    // Write single: Address(2) + Value(2)
+                    uint16_t addr;
+                    std::memcpy(&addr, data.data(), 2);
+                    meta.register_address = ntohs(addr);
+                    meta.register_count = 1;
+                    break;
                 }
-            } catch (...) {
-                // Silent fail for parsing
+
+                default:
+                    // Reads and multiple writes share a layout prefix:
+                    // Address(2) + Count(2)
+                    if (traits.isRead() || traits.isWrite()) {
+                        uint16_t addr, count;
+                        std::memcpy(&addr, data.data(), 2);
+                        std::memcpy(&count, data.data() + 2, 2);
+                        meta.register_address = ntohs(addr);
+                        meta.register_count = ntohs(count);
+                    }
+                    break;
             }
         }
         
@@ -189,6 +179,84 @@ namespace gw::scada {
         }
     };
 
+    // ========================================================================
+    // SIMD batch pre-classifier for MBAP headers
+    // ========================================================================
+    // Validates protocol_id == 0 and a plausible length field for a whole
+    // batch of packet pointers at once. Returns a bitmask where bit i set
+    // means packet i looks like a real Modbus TCP header and deserves a full
+    // parse; a clear bit means it can be marked malformed immediately -
+    // junk floods then cost one dword test instead of a parse attempt each.
+    //
+    // Bytes 2..5 of the MBAP header are exactly {protocol_id_hi,
+    // protocol_id_lo, length_hi, length_lo}, so plausibility of one header
+    // collapses to a single little-endian dword test:
+    //   (dword & 0x00FFFFFF) == 0   (protocol id zero, length < 256)
+    //   (dword & 0xFF000000) != 0   (length > 0)
+    inline uint64_t preclassifyModbusBatch(const std::byte* const* packets,
+                                           const size_t* lengths,
+                                           size_t count) noexcept {
+        count = std::min<size_t>(count, 64);
+        uint64_t valid = 0;
+
+        // Size gate (also guarantees bytes 2..5 are readable below)
+        uint64_t sized = 0;
+        for (size_t i = 0; i < count; ++i) {
+            if (lengths[i] >= ModbusTCPHeader::SIZE + 1 && lengths[i] <= 260) {
+                sized |= 1ULL << i;
+            }
+        }
+
+        size_t i = 0;
+
+#if defined(__AVX2__)
+        // 4 headers per iteration: gather the dword at offset 2 of each
+        // packet and run both tests across all lanes in parallel. Lanes
+        // that failed the size gate are masked out of the gather and fed a
+        // sentinel that fails the validity test.
+        const __m128i low24_mask = _mm_set1_epi32(0x00FFFFFF);
+        const __m128i hi8_mask = _mm_set1_epi32(static_cast<int>(0xFF000000));
+        const __m128i fail_sentinel = _mm_set1_epi32(-1);
+
+        for (; i + 4 <= count; i += 4) {
+            uint32_t m = static_cast<uint32_t>((sized >> i) & 0xF);
+            if (m == 0) continue;
+
+            __m256i vptr = _mm256_loadu_si256(
+                reinterpret_cast<const __m256i*>(packets + i));
+            __m128i lanemask = _mm_set_epi32(
+                (m & 8) ? -1 : 0, (m & 4) ? -1 : 0,
+                (m & 2) ? -1 : 0, (m & 1) ? -1 : 0);
+
+            __m128i dw = _mm256_mask_i64gather_epi32(
+                fail_sentinel,
+                reinterpret_cast<const int*>(uintptr_t{2}), // +2 byte offset
+                vptr, lanemask, 1);
+
+            __m128i ok_low = _mm_cmpeq_epi32(
+                _mm_and_si128(dw, low24_mask), _mm_setzero_si128());
+            __m128i bad_hi = _mm_cmpeq_epi32(
+                _mm_and_si128(dw, hi8_mask), _mm_setzero_si128());
+            __m128i ok = _mm_andnot_si128(bad_hi, ok_low);
+
+            uint32_t lanebits = static_cast<uint32_t>(
+                _mm_movemask_ps(_mm_castsi128_ps(ok)));
+            valid |= static_cast<uint64_t>(lanebits) << i;
+        }
+#endif
+
+        // Scalar tail (and full fallback when AVX2 is not compiled in)
+        for (; i < count; ++i) {
+            if (!((sized >> i) & 1)) continue;
+            const auto* p = reinterpret_cast<const uint8_t*>(packets[i]);
+            if (p[2] == 0 && p[3] == 0 && p[4] == 0 && p[5] != 0) {
+                valid |= 1ULL << i;
+            }
+        }
+
+        return valid;
+    }
+
     // Quick validation without full parsing
     inline bool isModbusTCP(std::span<const std::byte> data) noexcept {
         if (data.size() < ModbusTCPHeader::SIZE) {
@@ -0,0 +1,114 @@
+#pragma once
+
+// ============================================================================
+// Compile-time port -> protocol parser dispatch.
+//
+// buildPacketMetadata used to hardcode "port 502 => ModbusParser" with a
+// comment promising DNP3/IEC-104 "later". This registry makes adding a
+// protocol one ProtocolTraits specialization plus one line in the handler
+// table: the hot path does a single byte-array lookup (64KB, built at
+// compile time, indexed by port) instead of growing an if/else chain.
+// ============================================================================
+
+#include "modbus_parser.hpp"
+#include "dnp3_parser.hpp"
+#include "iec104_parser.hpp"
+#include <array>
+
+namespace gw::scada {
+
+    // Per-protocol binding: well-known port, quick header check, full parse.
+    // Specialized once per protocol; the table below is generated from these.
+    template<ProtocolType P>
+    struct ProtocolTraits;
+
+    template<>
+    struct ProtocolTraits<ProtocolType::MODBUS_TCP> {
+        static constexpr uint16_t PORT = 502;
+        static bool preview(std::span<const std::byte> data) noexcept {
+            return isModbusTCP(data);
+        }
+        static std::optional<PacketMetadata> parse(std::span<const std::byte> data) noexcept {
+            return ModbusParser::parse(data);
+        }
+    };
+
+    template<>
+    struct ProtocolTraits<ProtocolType::DNP3> {
+        static constexpr uint16_t PORT = 20000;
+        static bool preview(std::span<const std::byte> data) noexcept {
+            return isDNP3(data);
+        }
+        static std::optional<PacketMetadata> parse(std::span<const std::byte> data) noexcept {
+            return DNP3Parser::parse(data);
+        }
+    };
+
+    template<>
+    struct ProtocolTraits<ProtocolType::IEC_104> {
+        static constexpr uint16_t PORT = 2404;
+        static bool preview(std::span<const std::byte> data) noexcept {
+            return isIEC104(data);
+        }
+        static std::optional<PacketMetadata> parse(std::span<const std::byte> data) noexcept {
+            return IEC104Parser::parse(data);
+        }
+    };
+
+    // Uniform handler record (entry 0 = UNKNOWN, never parsed)
+    struct ProtocolHandler {
+        ProtocolType protocol;
+        bool (*preview)(std::span<const std::byte>) noexcept;
+        std::optional<PacketMetadata> (*parse)(std::span<const std::byte>) noexcept;
+    };
+
+    namespace detail {
+
+        template<ProtocolType P>
+        consteval ProtocolHandler makeHandler() noexcept {
+            return ProtocolHandler{
+                P,
+                &ProtocolTraits<P>::preview,
+                &ProtocolTraits<P>::parse
+            };
+        }
+
+    } // namespace detail
+
+    inline constexpr std::array<ProtocolHandler, 4> PROTOCOL_HANDLERS = {{
+        {ProtocolType::UNKNOWN, nullptr, nullptr},
+        detail::makeHandler<ProtocolType::MODBUS_TCP>(),
+        detail::makeHandler<ProtocolType::DNP3>(),
+        detail::makeHandler<ProtocolType::IEC_104>()
+    }};
+
+    namespace detail {
+
+        // Full 64K port map: one handler index per port, materialized at
+        // compile time so the hot path is a single indexed byte load -
+        // no comparison chain regardless of how many protocols register
+        consteval std::array<uint8_t, 65536> makePortMap() noexcept {
+            std::array<uint8_t, 65536> map{};  // 0 = UNKNOWN
+            map[ProtocolTraits<ProtocolType::MODBUS_TCP>::PORT] = 1;
+            map[ProtocolTraits<ProtocolType::DNP3>::PORT] = 2;
+            map[ProtocolTraits<ProtocolType::IEC_104>::PORT] = 3;
+            return map;
+        }
+
+        inline constexpr auto PORT_TO_HANDLER = makePortMap();
+
+    } // namespace detail
+
+    // HOT PATH: resolve the parser for a packet. Destination port wins
+    // (requests); source port catches responses flowing back from the
+    // well-known port.
+    inline const ProtocolHandler& protocolHandlerFor(uint16_t source_port,
+                                                     uint16_t dest_port) noexcept {
+        uint8_t idx = detail::PORT_TO_HANDLER[dest_port];
+        if (idx == 0) {
+            idx = detail::PORT_TO_HANDLER[source_port];
+        }
+        return PROTOCOL_HANDLERS[idx];
+    }
+
+} // namespace gw::scada
@@ -3,7 +3,9 @@
 #include <cstdint>
 #include <string>
 #include <chrono>
+#include <array>
 #include "../core/ipv4.hpp"
+#include "../performance/cache_utils.hpp"
 
 namespace gw::scada {
 
@@ -29,6 +31,76 @@ namespace gw::scada {
         EXCEPTION = 0x80  // High bit set = exception
     };
 
+    // ========================================================================
+    // Function-code classification table
+    // ========================================================================
+    // Single source of truth untuk klasifikasi function code. Sebelumnya
+    // read/write di-derive ulang dengan range comparison di tiga tempat
+    // (TrafficStats, FastTrafficStats, unauthorized-write rule) dan definisi
+    // write sempat drift. Sekarang: satu indexed load per packet, tidak ada
+    // branch chain, dan klasifikasi tidak mungkin drift lagi.
+    struct FcTraits {
+        enum : uint8_t {
+            NONE       = 0,
+            READ       = 1 << 0,
+            WRITE      = 1 << 1,
+            DIAGNOSTIC = 1 << 2
+        };
+
+        uint8_t flags = NONE;
+        uint8_t min_pdu_length = 0;  // FC byte + minimum data bytes (request)
+
+        [[nodiscard]] constexpr bool isRead() const noexcept { return (flags & READ) != 0; }
+        [[nodiscard]] constexpr bool isWrite() const noexcept { return (flags & WRITE) != 0; }
+        [[nodiscard]] constexpr bool isDiagnostic() const noexcept { return (flags & DIAGNOSTIC) != 0; }
+    };
+
+    namespace detail {
+
+        consteval std::array<FcTraits, 256> makeFcTraitsTable() noexcept {
+            std::array<FcTraits, 256> table{};
+
+            auto set = [&table](uint8_t fc, uint8_t flags, uint8_t min_len) {
+                table[fc] = FcTraits{flags, min_len};
+            };
+
+            // Reads: FC(1) + address(2) + count(2)
+            set(0x01, FcTraits::READ, 5);   // READ_COILS
+            set(0x02, FcTraits::READ, 5);   // READ_DISCRETE_INPUTS
+            set(0x03, FcTraits::READ, 5);   // READ_HOLDING_REGISTERS
+            set(0x04, FcTraits::READ, 5);   // READ_INPUT_REGISTERS
+
+            // Single writes: FC(1) + address(2) + value(2)
+            set(0x05, FcTraits::WRITE, 5);  // WRITE_SINGLE_COIL
+            set(0x06, FcTraits::WRITE, 5);  // WRITE_SINGLE_REGISTER
+
+            // Multiple writes: FC(1) + address(2) + count(2) + bytecount(1)
+            set(0x0F, FcTraits::WRITE, 6);  // WRITE_MULTIPLE_COILS
+            set(0x10, FcTraits::WRITE, 6);  // WRITE_MULTIPLE_REGISTERS
+
+            // Diagnostics / device identification
+            set(0x07, FcTraits::DIAGNOSTIC, 1);  // READ_EXCEPTION_STATUS
+            set(0x08, FcTraits::DIAGNOSTIC, 5);  // DIAGNOSTICS
+            set(0x0B, FcTraits::DIAGNOSTIC, 1);  // GET_COMM_EVENT_COUNTER
+            set(0x0C, FcTraits::DIAGNOSTIC, 1);  // GET_COMM_EVENT_LOG
+            set(0x11, FcTraits::DIAGNOSTIC, 1);  // REPORT_SERVER_ID
+
+            return table;
+        }
+
+    } // namespace detail
+
+    inline constexpr std::array<FcTraits, 256> FC_TRAITS = detail::makeFcTraitsTable();
+
+    // HOT PATH: satu indexed load, no branches
+    [[nodiscard]] constexpr const FcTraits& fcTraits(uint8_t fc) noexcept {
+        return FC_TRAITS[fc];
+    }
+
+    [[nodiscard]] constexpr const FcTraits& fcTraits(ModbusFunctionCode fc) noexcept {
+        return FC_TRAITS[static_cast<uint8_t>(fc)];
+    }
+
     // Severity levels untuk threat
     enum class ThreatLevel : uint8_t {
         INFO = 0,
@@ -77,8 +149,10 @@ namespace gw::scada {
         bool has_exception;
         bool is_malformed;
         
-        PacketMetadata() noexcept 
-            : timestamp(std::chrono::system_clock::now())
+        PacketMetadata() noexcept
+            // Coarse stamp: metadata is built per packet and nothing
+            // downstream needs sub-millisecond wall-clock precision
+            : timestamp(perf::CoarseClock::systemNow())
             , source_port(0)
             , dest_port(0)
             , protocol(ProtocolType::UNKNOWN)
@@ -123,8 +197,8 @@ namespace gw::scada {
             , exception_count(0)
             , write_operations(0)
             , read_operations(0)
-            , first_seen(std::chrono::system_clock::now())
-            , last_seen(std::chrono::system_clock::now())
+            , first_seen(perf::CoarseClock::systemNow())
+            , last_seen(perf::CoarseClock::systemNow())
             , packets_per_second(0.0)
             , bytes_per_second(0.0)
             , avg_packet_size(0.0)
@@ -146,23 +220,10 @@ namespace gw::scada {
                 exception_count++;
             }
             
-            // Count write vs read operations
-            switch (pkt.function_code) {
-                case ModbusFunctionCode::WRITE_SINGLE_COIL:
-                case ModbusFunctionCode::WRITE_SINGLE_REGISTER:
-                case ModbusFunctionCode::WRITE_MULTIPLE_COILS:
-                case ModbusFunctionCode::WRITE_MULTIPLE_REGISTERS:
-                    write_operations++;
-                    break;
-                case ModbusFunctionCode::READ_COILS:
-                case ModbusFunctionCode::READ_DISCRETE_INPUTS:
-                case ModbusFunctionCode::READ_HOLDING_REGISTERS:
-                case ModbusFunctionCode::READ_INPUT_REGISTERS:
-                    read_operations++;
-                    break;
-                default:
-                    break;
-            }
+            // Count write vs read operations (one table load, no branches)
+            const FcTraits& fc = fcTraits(pkt.function_code);
+            write_operations += fc.isWrite();
+            read_operations += fc.isRead();
             
             // Update metrics
             auto duration = std::chrono::duration<double>(last_seen - first_seen).count();
@@ -188,12 +249,12 @@ namespace gw::scada {
         TimePoint timestamp;
         net::ipv4 source_ip;
         net::ipv4 dest_ip;
-        AttackType attack_type;
+        AttackType attack_type;   // doubles as the message id - resolved to
+                                  // text via describe() at logging time only
         ThreatLevel severity;
-        std::string description;
         double confidence_score;  // 0.0 - 1.0
         bool auto_mitigated;
-        
+
         ThreatAlert() noexcept
             : timestamp(std::chrono::system_clock::now())
             , attack_type(AttackType::NONE)
@@ -201,21 +262,38 @@ namespace gw::scada {
             , confidence_score(0.0)
             , auto_mitigated(false)
         {}
-        
-        ThreatAlert(const net::ipv4& src, const net::ipv4& dst, 
-                   AttackType type, ThreatLevel level, 
-                   std::string_view desc, double confidence) noexcept
+
+        ThreatAlert(const net::ipv4& src, const net::ipv4& dst,
+                   AttackType type, ThreatLevel level,
+                   double confidence) noexcept
             : timestamp(std::chrono::system_clock::now())
             , source_ip(src)
             , dest_ip(dst)
             , attack_type(type)
             , severity(level)
-            , description(desc)
             , confidence_score(confidence)
             , auto_mitigated(false)
         {}
     };
 
+    // Human-readable detection message per attack type (cold path only -
+    // alerts themselves carry just the enum, never a string)
+    inline const char* describe(AttackType type) noexcept {
+        switch (type) {
+            case AttackType::PORT_SCAN: return "Port scan detected";
+            case AttackType::DOS_FLOOD: return "DoS flood detected";
+            case AttackType::MODBUS_COMMAND_INJECTION: return "Modbus command injection detected";
+            case AttackType::UNAUTHORIZED_WRITE: return "Unauthorized write to critical register";
+            case AttackType::ABNORMAL_TRAFFIC_PATTERN: return "Abnormal write/read ratio";
+            case AttackType::SUSPICIOUS_FUNCTION_CODE: return "Suspicious function code";
+            case AttackType::MALFORMED_PACKET: return "Malformed packet";
+            case AttackType::REPLAY_ATTACK: return "Replay attack detected";
+            case AttackType::MAN_IN_THE_MIDDLE: return "MITM attack detected";
+            case AttackType::BRUTE_FORCE: return "Brute force detected";
+            default: return "Unknown threat";
+        }
+    }
+
     // String conversion helpers
     inline const char* to_string(ProtocolType type) noexcept {
         switch (type) {
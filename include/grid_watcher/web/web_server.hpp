@@ -2,13 +2,22 @@
 
 #include "../grid_watcher.hpp"
 #include "../processing/packet_processor.hpp"
+#include "../core/tcp_socket.hpp"
 #include <string>
 #include <sstream>
 #include <thread>
 #include <atomic>
+#include <chrono>
+#include <memory>
 #include <vector>
+#include <functional>
 #include <unordered_map>
 
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#endif
+
 // Simplified HTTP server (for production, use a proper library like Crow/Drogon)
 namespace gw::web {
 
@@ -173,6 +182,10 @@ public:
         json << "    \"max_ns\": " << metrics.packet_latency.max_ns << ",\n";
         json << "    \"avg_ns\": " << metrics.packet_latency.avg_ns << ",\n";
         json << "    \"avg_us\": " << metrics.packet_latency.avg_us << ",\n";
+        json << "    \"p50_ns\": " << metrics.packet_latency.p50_ns << ",\n";
+        json << "    \"p90_ns\": " << metrics.packet_latency.p90_ns << ",\n";
+        json << "    \"p99_ns\": " << metrics.packet_latency.p99_ns << ",\n";
+        json << "    \"p999_ns\": " << metrics.packet_latency.p999_ns << ",\n";
         json << "    \"samples\": " << metrics.packet_latency.samples << "\n";
         json << "  },\n";
         json << "  \"throughput\": {\n";
@@ -180,12 +193,30 @@ public:
         json << "    \"bytes_per_sec\": " << metrics.throughput.bytes_per_sec << ",\n";
         json << "    \"mbps\": " << metrics.throughput.mbps << "\n";
         json << "  },\n";
-        json << "  \"memory_usage_mb\": " << metrics.memory_usage_mb << "\n";
+        json << "  \"memory_usage_mb\": " << metrics.memory_usage_mb << ",\n";
+
+        // Per-stage cycle breakdown (all zeros unless the engine was
+        // built with GW_PROFILE_STAGES)
+        json << "  \"stage_profile\": {\n";
+        json << "    \"enabled\": "
+             << (metrics.stage_profiling ? "true" : "false");
+        for (size_t i = 0; i < perf::STAGE_COUNT; ++i) {
+            const auto stage = static_cast<perf::Stage>(i);
+            json << ",\n    \"" << perf::stageName(stage) << "\": {\n";
+            json << "      \"avg_cycles\": "
+                 << metrics.stage_profile.avgCycles(stage) << ",\n";
+            json << "      \"total_cycles\": "
+                 << metrics.stage_profile.cycles[i] << ",\n";
+            json << "      \"samples\": "
+                 << metrics.stage_profile.samples[i] << "\n";
+            json << "    }";
+        }
+        json << "\n  }\n";
         json << "}";
-        
+
         return json.str();
     }
-    
+
     // GET /api/blocks
     std::string getBlockedIPs() {
         auto blocked = watcher_.getBlockedIPs();
@@ -253,7 +284,137 @@ public:
             return "{\"error\": \"" + JSON::escape(e.what()) + "\"}";
         }
     }
-    
+
+    // GET /api/subnet_blocks
+    std::string getBlockedSubnets() {
+        auto blocked = watcher_.getBlockedSubnets();
+
+        std::ostringstream json;
+        json << "{\n";
+        json << "  \"total\": " << blocked.size() << ",\n";
+        json << "  \"subnets\": [\n";
+
+        for (size_t i = 0; i < blocked.size(); ++i) {
+            const auto& block = blocked[i];
+
+            json << "    {\n";
+            json << "      \"cidr\": \"" << block.prefix.toString()
+                 << "/" << static_cast<unsigned>(block.prefix_length) << "\",\n";
+            json << "      \"reason\": \"" << scada::to_string(block.reason) << "\"\n";
+            json << "    }";
+
+            if (i < blocked.size() - 1) json << ",";
+            json << "\n";
+        }
+
+        json << "  ]\n";
+        json << "}";
+
+        return json.str();
+    }
+
+    // POST /api/block_subnet
+    std::string blockSubnet(const std::string& cidr) {
+        try {
+            unsigned int a, b, c, d, len;
+            if (sscanf(cidr.c_str(), "%u.%u.%u.%u/%u", &a, &b, &c, &d, &len) != 5
+                || len > 32) {
+                return "{\"error\": \"Invalid CIDR format (expected a.b.c.d/len)\"}";
+            }
+
+            net::ipv4 prefix({static_cast<uint8_t>(a), static_cast<uint8_t>(b),
+                             static_cast<uint8_t>(c), static_cast<uint8_t>(d)});
+
+            watcher_.blockSubnet(prefix, static_cast<uint8_t>(len),
+                                 scada::AttackType::NONE);
+
+            return "{\"success\": true, \"message\": \"Subnet blocked\"}";
+        } catch (const std::exception& e) {
+            return "{\"error\": \"" + JSON::escape(e.what()) + "\"}";
+        }
+    }
+
+    // POST /api/unblock_subnet
+    std::string unblockSubnet(const std::string& cidr) {
+        try {
+            unsigned int a, b, c, d, len;
+            if (sscanf(cidr.c_str(), "%u.%u.%u.%u/%u", &a, &b, &c, &d, &len) != 5
+                || len > 32) {
+                return "{\"error\": \"Invalid CIDR format (expected a.b.c.d/len)\"}";
+            }
+
+            net::ipv4 prefix({static_cast<uint8_t>(a), static_cast<uint8_t>(b),
+                             static_cast<uint8_t>(c), static_cast<uint8_t>(d)});
+
+            watcher_.unblockSubnet(prefix, static_cast<uint8_t>(len));
+
+            return "{\"success\": true, \"message\": \"Subnet unblocked\"}";
+        } catch (const std::exception& e) {
+            return "{\"error\": \"" + JSON::escape(e.what()) + "\"}";
+        }
+    }
+
+    // POST /api/reload - hot-reload detection thresholds. The body names
+    // only the knobs to change, e.g.
+    //   {"dos_packet_threshold": 800, "auto_block_duration_minutes": 30}
+    // Unnamed knobs keep their current values; structural settings
+    // (journal paths, critical registers, thread counts) are ignored by
+    // GridWatcher::reloadConfig and still require a restart.
+    std::string reloadConfig(const std::string& body) {
+        try {
+            auto cfg = watcher_.getConfig(); // copy of the live snapshot
+
+            // Minimal numeric field scan (bare or quoted values) - same
+            // no-parser approach as the other POST endpoints
+            auto field = [&body](const char* key, double& out) -> bool {
+                size_t kpos = body.find("\"" + std::string(key) + "\"");
+                if (kpos == std::string::npos) return false;
+                size_t colon = body.find(':', kpos);
+                if (colon == std::string::npos) return false;
+                size_t pos = body.find_first_not_of(" \t\"", colon + 1);
+                if (pos == std::string::npos) return false;
+                return sscanf(body.c_str() + pos, "%lf", &out) == 1;
+            };
+
+            int applied = 0;
+            double v;
+            if (field("dos_packet_threshold", v)) {
+                cfg.dos_packet_threshold = static_cast<uint32_t>(v);
+                ++applied;
+            }
+            if (field("dos_burst_size", v)) {
+                cfg.dos_burst_size = static_cast<uint32_t>(v);
+                ++applied;
+            }
+            if (field("port_scan_threshold", v)) {
+                cfg.port_scan_threshold = static_cast<uint32_t>(v);
+                ++applied;
+            }
+            if (field("write_read_ratio_threshold", v)) {
+                cfg.write_read_ratio_threshold = v;
+                ++applied;
+            }
+            if (field("auto_block_duration_minutes", v)) {
+                cfg.auto_block_duration =
+                    std::chrono::minutes(static_cast<int64_t>(v));
+                ++applied;
+            }
+
+            if (applied == 0) {
+                return "{\"error\": \"No reloadable settings in request\"}";
+            }
+            if (!watcher_.reloadConfig(cfg)) {
+                return "{\"error\": \"Rejected: config failed validation\"}";
+            }
+
+            std::ostringstream json;
+            json << "{\"success\": true, \"applied\": " << applied << "}";
+            return json.str();
+        } catch (const std::exception& e) {
+            return "{\"error\": \"" + JSON::escape(e.what()) + "\"}";
+        }
+    }
+
     // GET /api/processor/stats (if processor is available)
     std::string getProcessorStats() {
         if (!processor_) {
@@ -325,21 +486,94 @@ public:
 
 // ============================================================================
 // Prometheus Metrics Exporter
+//
+// Scrapes are decoupled from stats aggregation: a background task renders
+// the exposition text once per refresh interval into a double-buffered
+// string published through an atomic shared_ptr swap. Scrape handlers just
+// load the current buffer - zero formatting and zero sharded-counter
+// summation on the request path, so two Prometheus replicas plus a
+// dashboard polling every 5s no longer show up as latency blips on the
+// packet path.
 // ============================================================================
 class PrometheusExporter {
 private:
+    static constexpr std::chrono::milliseconds DEFAULT_REFRESH{1000};
+
     scada::GridWatcher& watcher_;
-    
+    std::chrono::milliseconds refresh_interval_;
+
+    // Published buffer. shared_ptr (not a raw two-slot pointer) so a reader
+    // that grabbed the old buffer keeps it alive across the swap instead of
+    // racing the renderer's next overwrite.
+    std::atomic<std::shared_ptr<const std::string>> current_{nullptr};
+
+    std::atomic<bool> running_{false};
+    std::thread refresh_thread_;
+
 public:
-    explicit PrometheusExporter(scada::GridWatcher& watcher)
-        : watcher_(watcher) {}
-    
+    explicit PrometheusExporter(
+            scada::GridWatcher& watcher,
+            std::chrono::milliseconds refresh_interval = DEFAULT_REFRESH)
+        : watcher_(watcher)
+        , refresh_interval_(refresh_interval) {}
+
+    ~PrometheusExporter() {
+        stop();
+    }
+
+    PrometheusExporter(const PrometheusExporter&) = delete;
+    PrometheusExporter& operator=(const PrometheusExporter&) = delete;
+
+    void start() {
+        if (running_.exchange(true)) return;
+
+        // Render synchronously once so the first scrape never sees an
+        // empty buffer
+        current_.store(std::make_shared<const std::string>(render()));
+
+        refresh_thread_ = std::thread([this]() { refreshLoop(); });
+    }
+
+    void stop() {
+        if (!running_.exchange(false)) return;
+        if (refresh_thread_.joinable()) {
+            refresh_thread_.join();
+        }
+    }
+
+    // Scrape path: one atomic load, no rendering, no stats aggregation
+    [[nodiscard]] std::shared_ptr<const std::string> scrape() const noexcept {
+        return current_.load(std::memory_order_acquire);
+    }
+
+    // Compatibility entry point: serves the cached buffer when the
+    // refresher is running, renders on demand otherwise
     std::string exportMetrics() {
+        if (auto cached = scrape()) {
+            return *cached;
+        }
+        return render();
+    }
+
+private:
+    void refreshLoop() {
+        while (running_.load(std::memory_order_relaxed)) {
+            std::this_thread::sleep_for(refresh_interval_);
+            if (!running_.load(std::memory_order_relaxed)) break;
+
+            // The expensive part (counter summation + formatting) happens
+            // here, on this thread, once per interval - never per scrape
+            current_.store(std::make_shared<const std::string>(render()),
+                           std::memory_order_release);
+        }
+    }
+
+    std::string render() {
         auto stats = watcher_.getStatistics();
         auto metrics = watcher_.getMetrics();
-        
+
         std::ostringstream out;
-        
+
         // Packet metrics
         out << "# HELP grid_watcher_packets_processed Total packets processed\n";
         out << "# TYPE grid_watcher_packets_processed counter\n";
@@ -362,23 +596,505 @@ public:
         out << "# TYPE grid_watcher_active_blocks gauge\n";
         out << "grid_watcher_active_blocks " << stats.active_blocks << "\n\n";
         
-        // Performance metrics
+        // Performance metrics: real quantiles from the latency histogram
         out << "# HELP grid_watcher_latency_microseconds Packet processing latency\n";
         out << "# TYPE grid_watcher_latency_microseconds summary\n";
-        out << "grid_watcher_latency_microseconds{quantile=\"0.0\"} " 
-            << metrics.packet_latency.min_ns / 1000.0 << "\n";
-        out << "grid_watcher_latency_microseconds{quantile=\"0.5\"} " 
-            << metrics.packet_latency.avg_us << "\n";
-        out << "grid_watcher_latency_microseconds{quantile=\"1.0\"} " 
-            << metrics.packet_latency.max_ns / 1000.0 << "\n\n";
+        out << "grid_watcher_latency_microseconds{quantile=\"0.5\"} "
+            << metrics.packet_latency.p50_ns / 1000.0 << "\n";
+        out << "grid_watcher_latency_microseconds{quantile=\"0.9\"} "
+            << metrics.packet_latency.p90_ns / 1000.0 << "\n";
+        out << "grid_watcher_latency_microseconds{quantile=\"0.99\"} "
+            << metrics.packet_latency.p99_ns / 1000.0 << "\n";
+        out << "grid_watcher_latency_microseconds{quantile=\"0.999\"} "
+            << metrics.packet_latency.p999_ns / 1000.0 << "\n";
+        out << "grid_watcher_latency_microseconds_sum "
+            << watcher_.getMetricsManager().packetProcessingLatency().totalLatencyNs() / 1000.0 << "\n";
+        out << "grid_watcher_latency_microseconds_count "
+            << metrics.packet_latency.samples << "\n\n";
+
+        // Cumulative histogram (seconds, per Prometheus convention)
+        const auto& tracker = watcher_.getMetricsManager().packetProcessingLatency();
+        out << "# HELP grid_watcher_latency_seconds Packet processing latency histogram\n";
+        out << "# TYPE grid_watcher_latency_seconds histogram\n";
+        static constexpr uint64_t kBoundsNs[] = {
+            250, 500, 1000, 2500, 5000, 10000, 25000, 50000,
+            100000, 250000, 500000, 1000000, 10000000, 100000000
+        };
+        for (uint64_t bound_ns : kBoundsNs) {
+            out << "grid_watcher_latency_seconds_bucket{le=\""
+                << bound_ns / 1e9 << "\"} "
+                << tracker.countAtOrBelow(bound_ns) << "\n";
+        }
+        out << "grid_watcher_latency_seconds_bucket{le=\"+Inf\"} "
+            << metrics.packet_latency.samples << "\n";
+        out << "grid_watcher_latency_seconds_sum "
+            << tracker.totalLatencyNs() / 1e9 << "\n";
+        out << "grid_watcher_latency_seconds_count "
+            << metrics.packet_latency.samples << "\n\n";
         
         // Throughput
         out << "# HELP grid_watcher_throughput_mbps Current throughput in Mbps\n";
         out << "# TYPE grid_watcher_throughput_mbps gauge\n";
         out << "grid_watcher_throughput_mbps " << metrics.throughput.mbps << "\n\n";
-        
+
+        // Per-stage cycle breakdown - only present in GW_PROFILE_STAGES
+        // builds, so dashboards never graph a wall of zeros
+        if constexpr (perf::StageProfiler::ENABLED) {
+            out << "# HELP grid_watcher_stage_cycles_total Sampled TSC cycles per pipeline stage\n";
+            out << "# TYPE grid_watcher_stage_cycles_total counter\n";
+            for (size_t i = 0; i < perf::STAGE_COUNT; ++i) {
+                out << "grid_watcher_stage_cycles_total{stage=\""
+                    << perf::stageName(static_cast<perf::Stage>(i)) << "\"} "
+                    << metrics.stage_profile.cycles[i] << "\n";
+            }
+            out << "\n";
+            out << "# HELP grid_watcher_stage_samples_total Sampled packets per pipeline stage\n";
+            out << "# TYPE grid_watcher_stage_samples_total counter\n";
+            for (size_t i = 0; i < perf::STAGE_COUNT; ++i) {
+                out << "grid_watcher_stage_samples_total{stage=\""
+                    << perf::stageName(static_cast<perf::Stage>(i)) << "\"} "
+                    << metrics.stage_profile.samples[i] << "\n";
+            }
+            out << "\n";
+        }
+
         return out.str();
     }
 };
 
+// ============================================================================
+// Epoll Event-Loop HTTP Server (Linux only)
+//
+// All API connections multiplex on ONE dedicated thread, pinned away from
+// the packet workers: no accept() blocking, no thread-per-connection, no
+// cores stolen when the NOC dashboard opens 30 concurrent polls. Routes
+// are resolved against a pre-built table (no per-request string parsing
+// beyond the request line), keep-alive is honored so pollers reuse their
+// connections, and the Prometheus endpoint serves the exporter's cached
+// buffer - the whole request path never touches the detection engine's
+// hot state beyond a snapshot read.
+// ============================================================================
+#ifdef __linux__
+
+class EpollHTTPServer {
+private:
+    static constexpr int MAX_EVENTS = 64;
+    static constexpr int EPOLL_TIMEOUT_MS = 500;
+    static constexpr size_t MAX_REQUEST_SIZE = 16 * 1024;
+    static constexpr size_t READ_CHUNK = 4096;
+
+    struct Connection {
+        net::TcpSocket socket;
+        std::string in_buf;
+        std::string out_buf;   // pending response bytes (partial writes)
+        bool keep_alive{true};
+        bool want_write{false};
+
+        explicit Connection(net::TcpSocket&& s) : socket(std::move(s)) {}
+    };
+
+    struct Route {
+        std::function<std::string(const std::string& body)> handler;
+        const char* content_type;
+    };
+
+    GridWatcherAPI api_;
+    PrometheusExporter* prometheus_;
+    uint16_t port_;
+    int pin_core_;
+
+    std::unordered_map<std::string, Route> routes_;  // "GET /api/status"
+    std::unordered_map<int, Connection> connections_;
+
+    std::atomic<bool> running_{false};
+    std::thread server_thread_;
+    int epoll_fd_{-1};
+    int wake_fd_{-1};  // eventfd: stop() pokes it so epoll_wait returns
+
+public:
+    // pin_core -1 = last core (furthest from the packet workers, which
+    // ShardedPacketProcessor pins starting at core 0)
+    EpollHTTPServer(scada::GridWatcher& watcher,
+                    processing::PacketProcessor* processor,
+                    uint16_t port,
+                    PrometheusExporter* prometheus = nullptr,
+                    int pin_core = -1)
+        : api_(watcher, processor)
+        , prometheus_(prometheus)
+        , port_(port)
+        , pin_core_(pin_core)
+    {
+        buildRoutes();
+    }
+
+    ~EpollHTTPServer() {
+        stop();
+    }
+
+    EpollHTTPServer(const EpollHTTPServer&) = delete;
+    EpollHTTPServer& operator=(const EpollHTTPServer&) = delete;
+
+    void start() {
+        if (running_.exchange(true)) return;
+        server_thread_ = std::thread([this]() { eventLoop(); });
+    }
+
+    void stop() {
+        if (!running_.exchange(false)) return;
+
+        if (wake_fd_ >= 0) {
+            uint64_t one = 1;
+            [[maybe_unused]] ssize_t n = write(wake_fd_, &one, sizeof(one));
+        }
+        if (server_thread_.joinable()) {
+            server_thread_.join();
+        }
+    }
+
+private:
+    // ========================================================================
+    // Route Table (built once - request dispatch is a single map lookup)
+    // ========================================================================
+    void buildRoutes() {
+        routes_["GET /api/status"] = {
+            [this](const std::string&) { return api_.getStatus(); },
+            "application/json"
+        };
+        routes_["GET /api/statistics"] = {
+            [this](const std::string&) { return api_.getStatistics(); },
+            "application/json"
+        };
+        routes_["GET /api/metrics"] = {
+            [this](const std::string&) { return api_.getMetrics(); },
+            "application/json"
+        };
+        routes_["GET /api/blocks"] = {
+            [this](const std::string&) { return api_.getBlockedIPs(); },
+            "application/json"
+        };
+        routes_["GET /api/subnet_blocks"] = {
+            [this](const std::string&) { return api_.getBlockedSubnets(); },
+            "application/json"
+        };
+        routes_["GET /api/processor/stats"] = {
+            [this](const std::string&) { return api_.getProcessorStats(); },
+            "application/json"
+        };
+        routes_["POST /api/block"] = {
+            [this](const std::string& body) {
+                return api_.blockIP(extractJsonField(body, "ip"));
+            },
+            "application/json"
+        };
+        routes_["POST /api/unblock"] = {
+            [this](const std::string& body) {
+                return api_.unblockIP(extractJsonField(body, "ip"));
+            },
+            "application/json"
+        };
+        routes_["POST /api/block_subnet"] = {
+            [this](const std::string& body) {
+                return api_.blockSubnet(extractJsonField(body, "cidr"));
+            },
+            "application/json"
+        };
+        routes_["POST /api/unblock_subnet"] = {
+            [this](const std::string& body) {
+                return api_.unblockSubnet(extractJsonField(body, "cidr"));
+            },
+            "application/json"
+        };
+        routes_["POST /api/reload"] = {
+            [this](const std::string& body) {
+                return api_.reloadConfig(body);
+            },
+            "application/json"
+        };
+        routes_["GET /metrics"] = {
+            [this](const std::string&) -> std::string {
+                if (prometheus_) {
+                    if (auto cached = prometheus_->scrape()) {
+                        return *cached;
+                    }
+                }
+                return "# prometheus exporter not running\n";
+            },
+            "text/plain; version=0.0.4"
+        };
+    }
+
+    // Minimal JSON field extraction: {"ip": "10.0.0.5"} - enough for the
+    // two POST endpoints, no parser dependency
+    static std::string extractJsonField(const std::string& body,
+                                        const std::string& key) {
+        size_t kpos = body.find("\"" + key + "\"");
+        if (kpos == std::string::npos) return "";
+        size_t colon = body.find(':', kpos);
+        if (colon == std::string::npos) return "";
+        size_t open = body.find('"', colon);
+        if (open == std::string::npos) return "";
+        size_t close = body.find('"', open + 1);
+        if (close == std::string::npos) return "";
+        return body.substr(open + 1, close - open - 1);
+    }
+
+    // ========================================================================
+    // Event Loop (single thread, pinned to its own core)
+    // ========================================================================
+    void eventLoop() {
+        pinThread();
+
+        net::TcpListener listener;
+        try {
+            listener.listen(net::SocketAddress(net::ipv4(uint32_t{0}), port_));
+            listener.setNonBlocking(true);
+        } catch (const std::exception& e) {
+            std::cerr << "[API] Failed to start on port " << port_
+                      << ": " << e.what() << "\n";
+            running_ = false;
+            return;
+        }
+
+        epoll_fd_ = epoll_create1(0);
+        wake_fd_ = eventfd(0, EFD_NONBLOCK);
+        if (epoll_fd_ < 0 || wake_fd_ < 0) {
+            std::cerr << "[API] epoll/eventfd setup failed\n";
+            running_ = false;
+            return;
+        }
+
+        addFd(listener.getHandle(), EPOLLIN);
+        addFd(wake_fd_, EPOLLIN);
+
+        std::cout << "[API] Event-loop server on port " << port_
+                  << " (epoll, single thread)\n";
+
+        struct epoll_event events[MAX_EVENTS];
+
+        while (running_.load(std::memory_order_relaxed)) {
+            int n = epoll_wait(epoll_fd_, events, MAX_EVENTS, EPOLL_TIMEOUT_MS);
+
+            for (int i = 0; i < n; ++i) {
+                int fd = events[i].data.fd;
+
+                if (fd == listener.getHandle()) {
+                    acceptConnections(listener);
+                } else if (fd == wake_fd_) {
+                    uint64_t drained;
+                    [[maybe_unused]] ssize_t r =
+                        read(wake_fd_, &drained, sizeof(drained));
+                } else {
+                    handleConnection(fd, events[i].events);
+                }
+            }
+        }
+
+        connections_.clear();
+        close(wake_fd_);
+        wake_fd_ = -1;
+        close(epoll_fd_);
+        epoll_fd_ = -1;
+    }
+
+    void pinThread() {
+        unsigned int cores = std::thread::hardware_concurrency();
+        if (cores == 0) return;
+
+        int core = (pin_core_ >= 0)
+                 ? pin_core_ % static_cast<int>(cores)
+                 : static_cast<int>(cores) - 1;
+
+        cpu_set_t cpuset;
+        CPU_ZERO(&cpuset);
+        CPU_SET(core, &cpuset);
+        pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuset);
+    }
+
+    void addFd(int fd, uint32_t events) {
+        struct epoll_event ev{};
+        ev.events = events;
+        ev.data.fd = fd;
+        epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &ev);
+    }
+
+    void modFd(int fd, uint32_t events) {
+        struct epoll_event ev{};
+        ev.events = events;
+        ev.data.fd = fd;
+        epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, fd, &ev);
+    }
+
+    void acceptConnections(net::TcpListener& listener) {
+        // Drain the accept queue - level-triggered epoll only reports once
+        // per wait, and a dashboard burst can queue several
+        for (;;) {
+            auto client = listener.accept();
+            if (!client) break;
+
+            client->setNonBlocking(true);
+            try {
+                client->setTcpNoDelay(true);
+            } catch (...) {
+                // Best effort: Nagle costs latency, not correctness
+            }
+
+            int fd = client->getHandle();
+            connections_.emplace(fd, Connection(std::move(*client)));
+            addFd(fd, EPOLLIN);
+        }
+    }
+
+    void handleConnection(int fd, uint32_t events) {
+        auto it = connections_.find(fd);
+        if (it == connections_.end()) return;
+        Connection& conn = it->second;
+
+        if (events & (EPOLLHUP | EPOLLERR)) {
+            closeConnection(it);
+            return;
+        }
+
+        if (events & EPOLLIN) {
+            auto status = conn.socket.tryReceive(conn.in_buf, READ_CHUNK);
+            if (status == net::IoResult::CLOSED) {
+                closeConnection(it);
+                return;
+            }
+            if (conn.in_buf.size() > MAX_REQUEST_SIZE) {
+                closeConnection(it); // oversized request: just drop it
+                return;
+            }
+            if (!processRequests(conn)) {
+                closeConnection(it);
+                return;
+            }
+        }
+
+        if (!conn.out_buf.empty() || (events & EPOLLOUT)) {
+            if (!flushOutput(conn)) {
+                closeConnection(it);
+                return;
+            }
+        }
+
+        // A non-keep-alive connection closes once its response is flushed
+        if (!conn.keep_alive && conn.out_buf.empty()) {
+            closeConnection(it);
+            return;
+        }
+
+        // Register for writability only while a partial response is pending
+        bool want_write = !conn.out_buf.empty();
+        if (want_write != conn.want_write) {
+            conn.want_write = want_write;
+            modFd(fd, EPOLLIN | (want_write ? EPOLLOUT : 0u));
+        }
+    }
+
+    void closeConnection(std::unordered_map<int, Connection>::iterator it) {
+        // closing the fd removes it from the epoll set automatically
+        connections_.erase(it);
+    }
+
+    // ========================================================================
+    // HTTP Parsing & Dispatch (handles pipelined keep-alive requests)
+    // ========================================================================
+    bool processRequests(Connection& conn) {
+        for (;;) {
+            size_t header_end = conn.in_buf.find("\r\n\r\n");
+            if (header_end == std::string::npos) {
+                return true; // incomplete: wait for more bytes
+            }
+
+            size_t body_len = parseContentLength(conn.in_buf, header_end);
+            size_t total = header_end + 4 + body_len;
+            if (conn.in_buf.size() < total) {
+                return true; // body still in flight
+            }
+
+            std::string_view head(conn.in_buf.data(), header_end);
+            std::string body = conn.in_buf.substr(header_end + 4, body_len);
+
+            if (!dispatch(conn, head, body)) {
+                return false; // malformed request line
+            }
+
+            conn.in_buf.erase(0, total);
+            if (conn.in_buf.empty()) return true;
+        }
+    }
+
+    static size_t parseContentLength(const std::string& buf,
+                                     size_t header_end) noexcept {
+        // Case-per-RFC: clients send "Content-Length"; tolerate lowercase
+        for (const char* name : {"Content-Length:", "content-length:"}) {
+            size_t pos = buf.find(name);
+            if (pos != std::string::npos && pos < header_end) {
+                return std::strtoul(buf.c_str() + pos + 15, nullptr, 10);
+            }
+        }
+        return 0;
+    }
+
+    bool dispatch(Connection& conn, std::string_view head,
+                  const std::string& body) {
+        // Request line: METHOD SP PATH SP VERSION
+        size_t sp1 = head.find(' ');
+        size_t sp2 = (sp1 == std::string_view::npos)
+                   ? std::string_view::npos : head.find(' ', sp1 + 1);
+        if (sp2 == std::string_view::npos) return false;
+
+        std::string method(head.substr(0, sp1));
+        std::string path(head.substr(sp1 + 1, sp2 - sp1 - 1));
+
+        // Strip query string: routing is path-only
+        if (size_t q = path.find('?'); q != std::string::npos) {
+            path.resize(q);
+        }
+
+        // HTTP/1.1 defaults to keep-alive; "Connection: close" opts out
+        conn.keep_alive = (head.find("Connection: close") == std::string_view::npos &&
+                           head.find("connection: close") == std::string_view::npos);
+
+        APIResponse response;
+        response.setHeader("Connection",
+                           conn.keep_alive ? "keep-alive" : "close");
+
+        if (method == "OPTIONS") {
+            // CORS preflight for the dashboard
+            response.setHeader("Access-Control-Allow-Methods",
+                               "GET, POST, OPTIONS");
+            response.setHeader("Access-Control-Allow-Headers", "Content-Type");
+            response.setBody("");
+        } else {
+            auto route = routes_.find(method + " " + path);
+            if (route == routes_.end()) {
+                response.setStatus(404);
+                response.setBody("{\"error\": \"Not found\"}");
+            } else {
+                response.setHeader("Content-Type", route->second.content_type);
+                response.setBody(route->second.handler(body));
+            }
+        }
+
+        conn.out_buf += response.build();
+        return true;
+    }
+
+    bool flushOutput(Connection& conn) {
+        while (!conn.out_buf.empty()) {
+            size_t sent = 0;
+            auto status = conn.socket.trySend(conn.out_buf, sent);
+
+            if (status == net::IoResult::CLOSED) return false;
+            if (status == net::IoResult::WOULD_BLOCK) return true;
+
+            conn.out_buf.erase(0, sent);
+        }
+        return true;
+    }
+};
+
+#endif // __linux__
+
 } // namespace gw::web
@@ -0,0 +1,63 @@
+// ============================================================================
+// FILE: src/alert_export.cpp
+// Dump the binary threat-alert journal to JSON (forensics / SIEM ingest)
+// ============================================================================
+
+#include "grid_watcher/scada/alert_journal.hpp"
+#include "grid_watcher/scada/types.hpp"
+#include "grid_watcher/core/ipv4.hpp"
+#include <cstdio>
+#include <iostream>
+
+using namespace gw;
+
+int main(int argc, char* argv[]) {
+    if (argc != 2) {
+        std::cerr << "Usage: " << argv[0] << " <alert_journal_file>\n"
+                  << "Dumps the retained alerts (oldest first) as a JSON "
+                  << "array to stdout.\n";
+        return 1;
+    }
+
+    scada::AlertJournal journal;
+    if (!journal.openReadOnly(argv[1])) {
+        std::cerr << "Failed to open journal: " << argv[1] << "\n";
+        return 1;
+    }
+
+    std::cout << "[\n";
+    bool first = true;
+
+    size_t exported = journal.forEach(
+        [&first](const scada::AlertJournal::Record& rec) {
+            if (!first) std::cout << ",\n";
+            first = false;
+
+            auto type = static_cast<scada::AttackType>(rec.attack_type);
+            auto level = static_cast<scada::ThreatLevel>(rec.severity);
+
+            std::cout << "  {\n"
+                      << "    \"seq\": " << rec.seq << ",\n"
+                      << "    \"timestamp_ns\": " << rec.timestamp_ns << ",\n"
+                      << "    \"source_ip\": \""
+                      << net::ipv4(rec.source_ip).toString() << "\",\n"
+                      << "    \"dest_ip\": \""
+                      << net::ipv4(rec.dest_ip).toString() << "\",\n"
+                      << "    \"attack_type\": \""
+                      << scada::to_string(type) << "\",\n"
+                      << "    \"description\": \""
+                      << scada::describe(type) << "\",\n"
+                      << "    \"severity\": \""
+                      << scada::to_string(level) << "\",\n"
+                      << "    \"confidence\": " << rec.confidence << ",\n"
+                      << "    \"auto_mitigated\": "
+                      << (rec.auto_mitigated ? "true" : "false") << "\n"
+                      << "  }";
+        });
+
+    std::cout << "\n]\n";
+    std::cerr << "Exported " << exported << " alerts ("
+              << journal.totalAppended() << " appended over the journal's "
+              << "lifetime)\n";
+    return 0;
+}
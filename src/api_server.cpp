@@ -1,52 +1,63 @@
+// ============================================================================
+// Grid-Watcher API Server
+//
+// Runs the detection engine with the epoll event-loop HTTP API: every
+// connection multiplexes on one dedicated thread, so dashboard polling
+// never steals cores from packet workers. On non-Linux platforms this
+// tool is unavailable (the event loop is epoll-based).
+// ============================================================================
+
 #include "grid_watcher/grid_watcher.hpp"
 #include "grid_watcher/web/web_server.hpp"
-#include <httplib.h> // Butuh install cpp-httplib
+#include <csignal>
+#include <iostream>
+#include <memory>
+
+#ifdef __linux__
+
+static std::atomic<bool> g_running{true};
+
+void signalHandler(int) {
+    g_running = false;
+}
 
 int main() {
+    std::signal(SIGINT, signalHandler);
+    std::signal(SIGTERM, signalHandler);
+
     auto config = gw::scada::DetectionConfig::createDefault();
-    gw::scada::GridWatcher watcher(config);
-    watcher.start();
-    
-    // HTTP Server
-    httplib::Server svr;
-    
-    // CORS
-    svr.set_pre_routing_handler([](const auto& req, auto& res) {
-        res.set_header("Access-Control-Allow-Origin", "*");
-        res.set_header("Access-Control-Allow-Methods", "GET, POST, OPTIONS");
-        res.set_header("Access-Control-Allow-Headers", "Content-Type");
-        return httplib::Server::HandlerResponse::Unhandled;
-    });
-    
-    // GET /api/statistics
-    svr.Get("/api/statistics", [&](const auto& req, auto& res) {
-        gw::web::GridWatcherAPI api(watcher);
-        res.set_content(api.getStatistics(), "application/json");
-    });
-    
-    // GET /api/metrics
-    svr.Get("/api/metrics", [&](const auto& req, auto& res) {
-        gw::web::GridWatcherAPI api(watcher);
-        res.set_content(api.getMetrics(), "application/json");
-    });
-    
-    // GET /api/blocks
-    svr.Get("/api/blocks", [&](const auto& req, auto& res) {
-        gw::web::GridWatcherAPI api(watcher);
-        res.set_content(api.getBlockedIPs(), "application/json");
-    });
-    
-    // POST /api/block
-    svr.Post("/api/block", [&](const auto& req, auto& res) {
-        // Parse JSON body untuk get IP
-        std::string ip = /* parse JSON */;
-        gw::web::GridWatcherAPI api(watcher);
-        res.set_content(api.blockIP(ip), "application/json");
-    });
-    
-    std::cout << "[API] Starting server on http://localhost:8080\n";
-    svr.listen("0.0.0.0", 8080);
-    
-    watcher.stop();
+    auto watcher = std::make_unique<gw::scada::GridWatcher>(config);
+    watcher->start();
+
+    // Prometheus text renders on its own refresher; /metrics serves the
+    // cached buffer
+    gw::web::PrometheusExporter prometheus(*watcher);
+    prometheus.start();
+
+    gw::web::EpollHTTPServer server(*watcher, nullptr, 8080, &prometheus);
+    server.start();
+
+    std::cout << "[API] http://localhost:8080\n";
+    std::cout << "[API] Endpoints: /api/status /api/statistics /api/metrics\n";
+    std::cout << "[API]            /api/blocks /api/block /api/unblock /metrics\n";
+    std::cout << "[API] Press Ctrl+C to stop.\n";
+
+    while (g_running.load()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    }
+
+    std::cout << "\n[API] Shutting down...\n";
+    server.stop();
+    prometheus.stop();
+    watcher->stop();
     return 0;
-}
\ No newline at end of file
+}
+
+#else
+
+int main() {
+    std::cerr << "api_server requires Linux (epoll event loop)\n";
+    return 1;
+}
+
+#endif
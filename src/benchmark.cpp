@@ -1,74 +1,179 @@
 // ============================================================================
-// Grid-Watcher v3.0 - Performance Benchmark Suite (FIXED)
+// Grid-Watcher v3.0 - Performance Benchmark Suite
+//
+// Statistical harness: every benchmark runs warmup trials first, then
+// repeated measured trials, and reports median / mean / stddev / p99 so a
+// real 3% regression is distinguishable from run-to-run noise. Results can
+// be exported as CSV or JSON (--csv / --json) for CI trend tracking.
+//
+// Coverage:
+//   - per-subsystem micro-benchmarks (BloomFilter, FastHashMap,
+//     ModbusParser, Logger enqueue)
+//   - end-to-end processPacket latency distribution
+//   - multi-threaded scaling of PacketProcessor and ShardedPacketProcessor
+//     over 1..N workers with realistic IP distributions (uniform, Zipfian
+//     sources, bursty flows) so queue contention and analyzer cache
+//     behavior actually show up in the numbers
 // ============================================================================
 
 #include "grid_watcher/grid_watcher.hpp"
 #include "grid_watcher/processing/packet_processor.hpp"
 #include <iostream>
 #include <iomanip>
+#include <fstream>
 #include <chrono>
 #include <random>
 #include <numeric>
 #include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+#include <string>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
 
 using namespace gw;
 using namespace std::chrono;
 
-void SetupConsole() {
-    // Set output ke UTF-8 biar garis-garisnya nyambung
+void setupConsole() {
+#ifdef _WIN32
+    // UTF-8 + ANSI escapes so the box-drawing banner renders correctly
     SetConsoleOutputCP(CP_UTF8);
     SetConsoleCP(CP_UTF8);
 
-    // Aktifkan ANSI Escape Sequences (biar bisa warna-warni & pindah kursor)
     HANDLE hOut = GetStdHandle(STD_OUTPUT_HANDLE);
     DWORD dwMode = 0;
     GetConsoleMode(hOut, &dwMode);
     dwMode |= ENABLE_VIRTUAL_TERMINAL_PROCESSING;
     SetConsoleMode(hOut, dwMode);
+#endif
+    // POSIX terminals need no setup
 }
 
 // ============================================================================
-// Benchmark Utilities
+// Statistics over a sample set (trial times or per-op latencies)
 // ============================================================================
-class BenchmarkTimer {
-private:
-    high_resolution_clock::time_point start_;
-    std::string name_;
-    
-public:
-    explicit BenchmarkTimer(std::string name) 
-        : start_(high_resolution_clock::now())
-        , name_(std::move(name)) {}
-    
-    ~BenchmarkTimer() {
-        auto end = high_resolution_clock::now();
-        auto duration = duration_cast<nanoseconds>(end - start_).count();
-        
-        std::cout << std::left << std::setw(40) << name_ 
-                  << std::right << std::setw(12) << duration << " ns\n";
+struct SampleStats {
+    double min{0}, median{0}, mean{0}, stddev{0}, p99{0}, max{0};
+    size_t count{0};
+
+    static SampleStats from(std::vector<double> samples) {
+        SampleStats s;
+        if (samples.empty()) return s;
+
+        std::sort(samples.begin(), samples.end());
+        s.count = samples.size();
+        s.min = samples.front();
+        s.max = samples.back();
+        s.median = samples[samples.size() / 2];
+        s.p99 = samples[std::min(samples.size() - 1,
+                                 samples.size() * 99 / 100)];
+        s.mean = std::accumulate(samples.begin(), samples.end(), 0.0)
+               / static_cast<double>(samples.size());
+
+        double var = 0.0;
+        for (double v : samples) {
+            var += (v - s.mean) * (v - s.mean);
+        }
+        s.stddev = std::sqrt(var / static_cast<double>(samples.size()));
+        return s;
     }
 };
 
+struct BenchResult {
+    std::string name;
+    std::string unit;  // "ns/op" or "pps"
+    SampleStats stats;
+};
+
+static std::vector<BenchResult> g_results;
+
+static void record(std::string name, std::string unit, SampleStats stats) {
+    g_results.push_back({std::move(name), std::move(unit), stats});
+}
+
+static void printResult(const BenchResult& r) {
+    std::cout << std::left << std::setw(44) << r.name << std::right
+              << std::fixed << std::setprecision(1)
+              << std::setw(12) << r.stats.median
+              << std::setw(12) << r.stats.mean
+              << std::setw(10) << r.stats.stddev
+              << std::setw(12) << r.stats.p99
+              << "  " << r.unit << "\n";
+}
+
+static void printHeader() {
+    std::cout << std::left << std::setw(44) << "Benchmark" << std::right
+              << std::setw(12) << "Median"
+              << std::setw(12) << "Mean"
+              << std::setw(10) << "Stddev"
+              << std::setw(12) << "P99" << "\n";
+    std::cout << std::string(96, '-') << "\n";
+}
+
 // ============================================================================
-// Test Data Generator (FIXED: Use proper random int types)
+// Benchmark Runner
+//
+// body() performs ops_per_trial operations; each trial is timed as a whole
+// and normalized to ns/op, so the clock reads stay out of the measured loop.
+// ============================================================================
+struct HarnessConfig {
+    int warmup_trials = 2;
+    int trials = 9;  // odd: the median is an actual sample
+    size_t max_threads = std::thread::hardware_concurrency();
+};
+
+static HarnessConfig g_harness;
+
+template<typename Body>
+static void runBench(const std::string& name, uint64_t ops_per_trial,
+                     Body&& body) {
+    for (int i = 0; i < g_harness.warmup_trials; ++i) {
+        body();
+    }
+
+    std::vector<double> ns_per_op;
+    ns_per_op.reserve(static_cast<size_t>(g_harness.trials));
+
+    for (int i = 0; i < g_harness.trials; ++i) {
+        auto start = high_resolution_clock::now();
+        body();
+        auto end = high_resolution_clock::now();
+
+        double ns = static_cast<double>(
+            duration_cast<nanoseconds>(end - start).count());
+        ns_per_op.push_back(ns / static_cast<double>(ops_per_trial));
+    }
+
+    auto stats = SampleStats::from(std::move(ns_per_op));
+    record(name, "ns/op", stats);
+    printResult(g_results.back());
+}
+
+// ============================================================================
+// Traffic Generators
 // ============================================================================
 class TestDataGenerator {
 private:
     std::mt19937 rng_;
-    std::uniform_int_distribution<unsigned int> byte_dist_;  // FIXED: Use unsigned int instead of uint8_t
+    std::uniform_int_distribution<unsigned int> byte_dist_;
     std::uniform_int_distribution<uint16_t> port_dist_;
-    
+
 public:
-    TestDataGenerator() 
-        : rng_(std::random_device{}())
-        , byte_dist_(0, 255)  // Range for bytes
+    // Fixed seed: benchmark inputs must be identical run to run, or the
+    // harness measures input variance instead of code changes
+    explicit TestDataGenerator(uint32_t seed = 0xC0FFEE)
+        : rng_(seed)
+        , byte_dist_(0, 255)
         , port_dist_(1024, 65535)
     {}
-    
+
     std::vector<std::byte> generateModbusPacket(size_t size = 64) {
         std::vector<std::byte> packet;
         packet.reserve(size);
-        
+
         // MBAP Header
         packet.push_back(std::byte(0x00)); // Transaction ID MSB
         packet.push_back(std::byte(0x01)); // Transaction ID LSB
@@ -77,22 +182,21 @@ public:
         packet.push_back(std::byte(0x00)); // Length MSB
         packet.push_back(std::byte(0x06)); // Length LSB
         packet.push_back(std::byte(0x01)); // Unit ID
-        
-        // PDU
-        packet.push_back(std::byte(0x03)); // Function code (Read Holding Registers)
-        packet.push_back(std::byte(0x00)); // Address MSB
-        packet.push_back(std::byte(0x64)); // Address LSB (100)
-        packet.push_back(std::byte(0x00)); // Count MSB
-        packet.push_back(std::byte(0x0A)); // Count LSB (10)
-        
-        // Fill remaining bytes
+
+        // PDU: Read Holding Registers, address 100, count 10
+        packet.push_back(std::byte(0x03));
+        packet.push_back(std::byte(0x00));
+        packet.push_back(std::byte(0x64));
+        packet.push_back(std::byte(0x00));
+        packet.push_back(std::byte(0x0A));
+
         while (packet.size() < size) {
             packet.push_back(std::byte(static_cast<uint8_t>(byte_dist_(rng_))));
         }
-        
+
         return packet;
     }
-    
+
     net::ipv4 randomIP() {
         return net::ipv4({
             static_cast<uint8_t>(byte_dist_(rng_)),
@@ -101,288 +205,427 @@ public:
             static_cast<uint8_t>(byte_dist_(rng_))
         });
     }
-    
+
     uint16_t randomPort() {
         return port_dist_(rng_);
     }
+
+    uint32_t randomU32() {
+        return rng_();
+    }
+};
+
+// Zipfian source-IP generator: a few talkers dominate (like a real SCADA
+// segment where the HMI and historian produce most traffic). Exponent 1.0
+// over NUM_SOURCES addresses in 10.42.0.0/16.
+class ZipfianIPGenerator {
+private:
+    static constexpr size_t NUM_SOURCES = 1024;
+
+    std::mt19937 rng_;
+    std::uniform_real_distribution<double> uniform_{0.0, 1.0};
+    std::vector<double> cdf_;
+
+public:
+    explicit ZipfianIPGenerator(uint32_t seed = 0xBEEF)
+        : rng_(seed)
+    {
+        cdf_.reserve(NUM_SOURCES);
+        double sum = 0.0;
+        for (size_t i = 1; i <= NUM_SOURCES; ++i) {
+            sum += 1.0 / static_cast<double>(i);
+            cdf_.push_back(sum);
+        }
+        for (auto& v : cdf_) v /= sum;
+    }
+
+    net::ipv4 next() {
+        double u = uniform_(rng_);
+        size_t rank = static_cast<size_t>(
+            std::lower_bound(cdf_.begin(), cdf_.end(), u) - cdf_.begin());
+        return net::ipv4({10, 42,
+                          static_cast<uint8_t>(rank >> 8),
+                          static_cast<uint8_t>(rank & 0xFF)});
+    }
+};
+
+// Bursty flow generator: one source emits a run of 16..64 back-to-back
+// packets before the next source takes over - the worst case for a
+// flow-sharded processor (whole bursts land on one worker).
+class BurstyIPGenerator {
+private:
+    ZipfianIPGenerator sources_;
+    std::mt19937 rng_;
+    std::uniform_int_distribution<uint32_t> burst_len_{16, 64};
+
+    net::ipv4 current_{net::ipv4({10, 42, 0, 0})};
+    uint32_t remaining_{0};
+
+public:
+    explicit BurstyIPGenerator(uint32_t seed = 0xFEED)
+        : sources_(seed), rng_(seed ^ 0x5A5A5A5A) {}
+
+    net::ipv4 next() {
+        if (remaining_ == 0) {
+            current_ = sources_.next();
+            remaining_ = burst_len_(rng_);
+        }
+        --remaining_;
+        return current_;
+    }
 };
 
 // ============================================================================
-// Latency Benchmarks
+// Subsystem Micro-Benchmarks
 // ============================================================================
-void benchmarkPacketProcessingLatency() {
-    std::cout << "\n=== PACKET PROCESSING LATENCY ===\n\n";
-    
-    auto config = scada::DetectionConfig::createDefault();
-    scada::GridWatcher watcher(config, "benchmark.log");
-    watcher.start();
-    
+void benchmarkSubsystems() {
+    std::cout << "\n=== SUBSYSTEM MICRO-BENCHMARKS ===\n\n";
+    printHeader();
+
+    constexpr uint64_t OPS = 100'000;
     TestDataGenerator gen;
-    constexpr int ITERATIONS = 10000;
-    
-    // Warm-up
-    for (int i = 0; i < 1000; ++i) {
-        auto packet = gen.generateModbusPacket();
-        watcher.processPacket(packet, gen.randomIP(), gen.randomIP(), 5000, 502);
+
+    // Pre-generate keys so the RNG stays out of the measured loop
+    std::vector<uint32_t> keys;
+    keys.reserve(OPS);
+    for (uint64_t i = 0; i < OPS; ++i) {
+        keys.push_back(gen.randomU32());
     }
-    
-    // 1. Normal packet latency
+
+    // ---- BloomFilter -------------------------------------------------------
     {
-        std::vector<uint64_t> latencies;
-        latencies.reserve(ITERATIONS);
-        
-        for (int i = 0; i < ITERATIONS; ++i) {
-            auto packet = gen.generateModbusPacket();
-            auto src_ip = gen.randomIP();
-            auto dst_ip = gen.randomIP();
-            
-            auto start = high_resolution_clock::now();
-            watcher.processPacket(packet, src_ip, dst_ip, 5000, 502);
-            auto end = high_resolution_clock::now();
-            
-            latencies.push_back(duration_cast<nanoseconds>(end - start).count());
-        }
-        
-        std::sort(latencies.begin(), latencies.end());
-        auto min = latencies.front();
-        auto max = latencies.back();
-        auto avg = std::accumulate(latencies.begin(), latencies.end(), 0ULL) / latencies.size();
-        auto p50 = latencies[latencies.size() / 2];
-        auto p95 = latencies[latencies.size() * 95 / 100];
-        auto p99 = latencies[latencies.size() * 99 / 100];
-        
-        std::cout << "Normal Packet Latency:\n";
-        std::cout << "  Min:  " << std::setw(8) << min << " ns\n";
-        std::cout << "  Avg:  " << std::setw(8) << avg << " ns\n";
-        std::cout << "  P50:  " << std::setw(8) << p50 << " ns\n";
-        std::cout << "  P95:  " << std::setw(8) << p95 << " ns\n";
-        std::cout << "  P99:  " << std::setw(8) << p99 << " ns\n";
-        std::cout << "  Max:  " << std::setw(8) << max << " ns\n\n";
+        auto filter = std::make_unique<perf::BloomFilter<8192, 3>>();
+        for (size_t i = 0; i < 1024; ++i) filter->add(keys[i]);
+
+        runBench("BloomFilter::add", OPS, [&]() {
+            for (uint64_t i = 0; i < OPS; ++i) filter->add(keys[i]);
+        });
+
+        volatile uint64_t hits = 0;
+        runBench("BloomFilter::contains", OPS, [&]() {
+            uint64_t h = 0;
+            for (uint64_t i = 0; i < OPS; ++i) h += filter->contains(keys[i]);
+            hits = hits + h;
+        });
     }
-    
-    // 2. Whitelisted IP latency
+
+    // ---- FastHashMap -------------------------------------------------------
     {
-        config.whitelisted_ips.push_back(net::ipv4({192, 168, 1, 10}));
-        net::ipv4 whitelisted({192, 168, 1, 10});
-        
-        std::vector<uint64_t> latencies;
-        latencies.reserve(ITERATIONS);
-        
-        for (int i = 0; i < ITERATIONS; ++i) {
-            auto packet = gen.generateModbusPacket();
-            
-            auto start = high_resolution_clock::now();
-            watcher.processPacket(packet, whitelisted, gen.randomIP(), 5000, 502);
-            auto end = high_resolution_clock::now();
-            
-            latencies.push_back(duration_cast<nanoseconds>(end - start).count());
-        }
-        
-        auto avg = std::accumulate(latencies.begin(), latencies.end(), 0ULL) / latencies.size();
-        std::cout << "Whitelisted IP Latency:  " << std::setw(8) << avg << " ns\n\n";
+        // 64K-slot table: too big for the stack, and we stay under the 75%
+        // load factor cap with 16K distinct keys
+        auto map = std::make_unique<perf::FastHashMap<uint64_t, 65536>>();
+        constexpr uint64_t MAP_KEYS = 16'384;
+
+        runBench("FastHashMap::emplace (16K keys)", MAP_KEYS, [&]() {
+            for (uint64_t i = 0; i < MAP_KEYS; ++i) {
+                map->emplace(keys[i], i);
+            }
+        });
+
+        volatile uint64_t found = 0;
+        runBench("FastHashMap::find (hit)", MAP_KEYS, [&]() {
+            uint64_t f = 0;
+            for (uint64_t i = 0; i < MAP_KEYS; ++i) {
+                f += (map->find(keys[i]) != nullptr);
+            }
+            found = found + f;
+        });
     }
-    
-    // 3. Blocked IP latency
+
+    // ---- ModbusParser ------------------------------------------------------
     {
-        net::ipv4 blocked_ip({10, 0, 0, 50});
-        watcher.blockIP(blocked_ip);
-        
-        std::vector<uint64_t> latencies;
-        latencies.reserve(ITERATIONS);
-        
-        for (int i = 0; i < ITERATIONS; ++i) {
-            auto packet = gen.generateModbusPacket();
-            
-            auto start = high_resolution_clock::now();
-            watcher.processPacket(packet, blocked_ip, gen.randomIP(), 5000, 502);
-            auto end = high_resolution_clock::now();
-            
-            latencies.push_back(duration_cast<nanoseconds>(end - start).count());
+        std::vector<std::vector<std::byte>> packets;
+        packets.reserve(256);
+        for (int i = 0; i < 256; ++i) {
+            packets.push_back(gen.generateModbusPacket(64));
         }
-        
-        auto avg = std::accumulate(latencies.begin(), latencies.end(), 0ULL) / latencies.size();
-        std::cout << "Blocked IP Latency:      " << std::setw(8) << avg << " ns\n\n";
+
+        volatile uint64_t parsed = 0;
+        runBench("ModbusParser::parse", OPS, [&]() {
+            uint64_t p = 0;
+            for (uint64_t i = 0; i < OPS; ++i) {
+                p += scada::ModbusParser::parse(packets[i % 256]).has_value();
+            }
+            parsed = parsed + p;
+        });
+    }
+
+    // ---- Logger enqueue ----------------------------------------------------
+    {
+        capture::Logger logger("benchmark.log",
+                               capture::LogEntry::Level::INFO,
+                               /*console_output=*/false);
+        logger.start();
+
+        auto entry = capture::LogEntry::make(capture::LogEntry::Level::INFO,
+                                             capture::LogSource::MONITOR,
+                                             capture::LogMessage::MONITOR_STATS);
+
+        // The writer drains concurrently; overflow counts as drops, which
+        // is exactly the hot-path behavior under a log storm
+        runBench("Logger::log (enqueue)", OPS, [&]() {
+            for (uint64_t i = 0; i < OPS; ++i) logger.log(entry);
+        });
+
+        logger.stop();
     }
-    
-    watcher.stop();
 }
 
 // ============================================================================
-// Throughput Benchmarks
+// End-to-End Latency Distribution
 // ============================================================================
-void benchmarkThroughput() {
-    std::cout << "\n=== THROUGHPUT BENCHMARKS ===\n\n";
-    
+void benchmarkPacketLatency() {
+    std::cout << "\n=== PACKET PROCESSING LATENCY ===\n\n";
+    printHeader();
+
+    net::ipv4 whitelisted({192, 168, 1, 10});
+
     auto config = scada::DetectionConfig::createDefault();
-    scada::GridWatcher watcher(config, "benchmark.log");
-    watcher.start();
-    
+    config.whitelisted_ips.push_back(whitelisted);
+    auto watcher = std::make_unique<scada::GridWatcher>(config, "benchmark.log");
+    watcher->start();
+
     TestDataGenerator gen;
-    
-    // Single-threaded throughput
-    {
-        constexpr int PACKETS = 100000;
-        auto start = high_resolution_clock::now();
-        
-        for (int i = 0; i < PACKETS; ++i) {
-            auto packet = gen.generateModbusPacket();
-            watcher.processPacket(packet, gen.randomIP(), gen.randomIP(), 5000, 502);
-        }
-        
-        auto end = high_resolution_clock::now();
-        auto duration = duration_cast<milliseconds>(end - start).count();
-        double pps = (PACKETS * 1000.0) / duration;
-        
-        std::cout << "Single-Threaded:\n";
-        std::cout << "  Packets:     " << PACKETS << "\n";
-        std::cout << "  Duration:    " << duration << " ms\n";
-        std::cout << "  Throughput:  " << std::fixed << std::setprecision(2) 
-                  << pps << " pps\n\n";
+    constexpr int ITERATIONS = 10'000;
+
+    // Pre-generate inputs
+    std::vector<std::vector<std::byte>> packets;
+    std::vector<net::ipv4> src_ips, dst_ips;
+    packets.reserve(ITERATIONS);
+    src_ips.reserve(ITERATIONS);
+    dst_ips.reserve(ITERATIONS);
+    for (int i = 0; i < ITERATIONS; ++i) {
+        packets.push_back(gen.generateModbusPacket());
+        src_ips.push_back(gen.randomIP());
+        dst_ips.push_back(gen.randomIP());
+    }
+
+    // Warm-up
+    for (int i = 0; i < 1000; ++i) {
+        (void)watcher->processPacket(packets[i], src_ips[i], dst_ips[i],
+                                     5000, 502);
     }
-    
-    watcher.stop();
+
+    // Per-op latency samples (this one keeps the clock inside the loop on
+    // purpose: we want the distribution, not just the mean)
+    auto sampleLatency = [&](const std::string& name, auto&& op) {
+        std::vector<double> latencies;
+        latencies.reserve(ITERATIONS);
+
+        for (int i = 0; i < ITERATIONS; ++i) {
+            auto start = high_resolution_clock::now();
+            op(i);
+            auto end = high_resolution_clock::now();
+            latencies.push_back(static_cast<double>(
+                duration_cast<nanoseconds>(end - start).count()));
+        }
+
+        auto stats = SampleStats::from(std::move(latencies));
+        record(name, "ns/op", stats);
+        printResult(g_results.back());
+    };
+
+    sampleLatency("processPacket (normal)", [&](int i) {
+        (void)watcher->processPacket(packets[i], src_ips[i], dst_ips[i],
+                                     5000, 502);
+    });
+
+    sampleLatency("processPacket (whitelisted src)", [&](int i) {
+        (void)watcher->processPacket(packets[i], whitelisted, dst_ips[i],
+                                     5000, 502);
+    });
+
+    net::ipv4 blocked({10, 0, 0, 50});
+    watcher->blockIP(blocked);
+    sampleLatency("processPacket (blocked src)", [&](int i) {
+        (void)watcher->processPacket(packets[i], blocked, dst_ips[i],
+                                     5000, 502);
+    });
+
+    watcher->stop();
 }
 
 // ============================================================================
-// Multi-Threaded Benchmarks (FIXED: Remove unused capture)
+// Multi-Threaded Scaling
+//
+// Drives a processor with N submitters against N workers and measures
+// sustained drain rate. Submitters retry on queue-full, so the number is
+// the rate the pipeline actually absorbs, not the rate we can drop at it.
 // ============================================================================
-void benchmarkMultiThreaded() {
-    std::cout << "\n=== MULTI-THREADED PERFORMANCE ===\n\n";
-    
-    auto config = scada::DetectionConfig::createDefault();
-    scada::GridWatcher watcher(config, "benchmark.log");
-    watcher.start();
-    
+template<typename Processor, typename NextIP>
+double measureScaling(scada::GridWatcher& watcher, size_t num_threads,
+                      NextIP&& make_ip_generator) {
+    constexpr uint64_t PACKETS_PER_THREAD = 50'000;
+
+    Processor processor(watcher, num_threads);
+    processor.start();
+
     TestDataGenerator gen;
-    
-    for (size_t num_threads : {1, 2, 4, 8, 16}) {
-        if (num_threads > std::thread::hardware_concurrency()) break;
-        
-        processing::PacketProcessor processor(watcher, num_threads);
-        processor.start();
-        
-        constexpr int PACKETS_PER_THREAD = 10000;
-        const int TOTAL_PACKETS = static_cast<int>(PACKETS_PER_THREAD * num_threads);
-        
-        auto start = high_resolution_clock::now();
-        
-        // Submit packets from multiple threads
-        std::vector<std::thread> submitters;
-        for (size_t t = 0; t < num_threads; ++t) {
-            submitters.emplace_back([&]() {  // FIXED: Removed unused capture 't'
-                TestDataGenerator local_gen;
-                for (int i = 0; i < PACKETS_PER_THREAD; ++i) {
-                    auto packet = local_gen.generateModbusPacket();
-                    processor.submitPacket(
-                        std::move(packet),
-                        local_gen.randomIP(),
-                        local_gen.randomIP(),
-                        5000, 502
-                    );
-                }
-            });
-        }
-        
-        for (auto& t : submitters) {
-            t.join();
-        }
-        
-        // Wait for processing to complete
-        while (static_cast<int>(processor.getStats().packets_processed) < TOTAL_PACKETS) {
-            std::this_thread::sleep_for(milliseconds(10));
+    auto packet = gen.generateModbusPacket();
+    net::ipv4 dst({10, 42, 255, 1});
+
+    // Pre-generate each submitter's IP sequence
+    std::vector<std::vector<net::ipv4>> sequences(num_threads);
+    for (size_t t = 0; t < num_threads; ++t) {
+        auto ip_gen = make_ip_generator(static_cast<uint32_t>(t));
+        sequences[t].reserve(PACKETS_PER_THREAD);
+        for (uint64_t i = 0; i < PACKETS_PER_THREAD; ++i) {
+            sequences[t].push_back(ip_gen.next());
         }
-        
-        auto end = high_resolution_clock::now();
-        auto duration = duration_cast<milliseconds>(end - start).count();
-        double pps = (TOTAL_PACKETS * 1000.0) / duration;
-        
-        std::cout << std::setw(2) << num_threads << " threads:  "
-                  << std::fixed << std::setprecision(2) << std::setw(12) 
-                  << pps << " pps\n";
-        
-        processor.stop();
     }
-    
-    std::cout << "\n";
-    watcher.stop();
+
+    const uint64_t total = PACKETS_PER_THREAD * num_threads;
+    auto start = high_resolution_clock::now();
+
+    std::vector<std::thread> submitters;
+    submitters.reserve(num_threads);
+    for (size_t t = 0; t < num_threads; ++t) {
+        submitters.emplace_back([&, t]() {
+            for (const auto& src : sequences[t]) {
+                while (!processor.submitPacket(packet, src, dst, 5000, 502)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    for (auto& t : submitters) t.join();
+
+    while (processor.getStats().packets_processed < total) {
+        std::this_thread::sleep_for(milliseconds(1));
+    }
+
+    auto end = high_resolution_clock::now();
+    processor.stop();
+
+    double sec = duration<double>(end - start).count();
+    return static_cast<double>(total) / sec;
 }
 
-// ============================================================================
-// Memory Benchmarks
-// ============================================================================
-void benchmarkMemoryUsage() {
-    std::cout << "\n=== MEMORY USAGE ===\n\n";
-    
-    auto config = scada::DetectionConfig::createDefault();
-    
-    {
-        scada::GridWatcher watcher(config, "benchmark.log");
-        watcher.start();
-        
-        TestDataGenerator gen;
-        
-        // Process many packets
-        for (int i = 0; i < 100000; ++i) {
-            auto packet = gen.generateModbusPacket();
-            watcher.processPacket(packet, gen.randomIP(), gen.randomIP(), 5000, 502);
-        }
-        
-        auto metrics = watcher.getMetrics();
-        std::cout << "After 100K packets:  " 
-                  << std::fixed << std::setprecision(2) 
-                  << metrics.memory_usage_mb << " MB\n";
-        
-        watcher.stop();
+template<typename Processor>
+void benchmarkScalingFor(const std::string& label,
+                         scada::GridWatcher& watcher) {
+    for (size_t num_threads : {1u, 2u, 4u, 8u, 16u}) {
+        if (num_threads > g_harness.max_threads) break;
+
+        // Uniform: every packet a new source - no flow locality at all
+        struct UniformGen {
+            TestDataGenerator gen;
+            explicit UniformGen(uint32_t seed) : gen(seed) {}
+            net::ipv4 next() { return gen.randomIP(); }
+        };
+
+        auto runDist = [&](const char* dist, auto make_gen) {
+            std::vector<double> pps;
+            constexpr int SCALING_TRIALS = 3;
+            for (int i = 0; i < SCALING_TRIALS; ++i) {
+                pps.push_back(measureScaling<Processor>(
+                    watcher, num_threads, make_gen));
+            }
+            auto stats = SampleStats::from(std::move(pps));
+
+            std::string name = label + " " + std::to_string(num_threads)
+                             + "T " + dist;
+            record(name, "pps", stats);
+            printResult(g_results.back());
+        };
+
+        runDist("uniform", [](uint32_t seed) { return UniformGen(seed); });
+        runDist("zipfian", [](uint32_t seed) { return ZipfianIPGenerator(seed); });
+        runDist("bursty", [](uint32_t seed) { return BurstyIPGenerator(seed); });
     }
-    
-    // Measure final memory to check for leaks
-    std::cout << "\nMemory leak check: OK (destructor called)\n\n";
+}
+
+void benchmarkScaling() {
+    std::cout << "\n=== MULTI-THREADED SCALING ===\n\n";
+    printHeader();
+
+    auto config = scada::DetectionConfig::createDefault();
+    auto watcher = std::make_unique<scada::GridWatcher>(config, "benchmark.log");
+    watcher->start();
+
+    benchmarkScalingFor<processing::PacketProcessor>(
+        "PacketProcessor", *watcher);
+    benchmarkScalingFor<processing::ShardedPacketProcessor>(
+        "ShardedProcessor", *watcher);
+
+    watcher->stop();
 }
 
 // ============================================================================
-// Scalability Benchmarks (FIXED: Use std::min for correct types)
+// Result Export (CSV / JSON for CI trend tracking)
 // ============================================================================
-void benchmarkScalability() {
-    std::cout << "\n=== SCALABILITY ===\n\n";
-    
-    TestDataGenerator gen;
-    
-    for (size_t packet_rate : {1000, 10000, 100000, 1000000}) {
-        auto config = scada::DetectionConfig::createDefault();
-        scada::GridWatcher watcher(config, "benchmark.log");
-        watcher.start();
-        
-        auto start = high_resolution_clock::now();
-        
-        // FIXED: Use proper types for std::min
-        size_t test_count = (std::min)(packet_rate, static_cast<size_t>(1000000));
-        
-        for (size_t i = 0; i < test_count; ++i) {
-            auto packet = gen.generateModbusPacket();
-            watcher.processPacket(packet, gen.randomIP(), gen.randomIP(), 5000, 502);
-        }
-        
-        auto end = high_resolution_clock::now();
-        auto duration = duration_cast<milliseconds>(end - start).count();
-        
-        if (duration > 0) {
-            double actual_pps = (test_count * 1000.0) / duration;
-            std::cout << "Target " << std::setw(8) << packet_rate << " pps:  "
-                      << "Achieved " << std::fixed << std::setprecision(2) 
-                      << actual_pps << " pps\n";
-        }
-        
-        watcher.stop();
+static bool exportCsv(const std::string& path) {
+    std::ofstream out(path);
+    if (!out.is_open()) return false;
+
+    out << "name,unit,samples,min,median,mean,stddev,p99,max\n";
+    for (const auto& r : g_results) {
+        out << '"' << r.name << "\"," << r.unit << ','
+            << r.stats.count << ','
+            << r.stats.min << ',' << r.stats.median << ','
+            << r.stats.mean << ',' << r.stats.stddev << ','
+            << r.stats.p99 << ',' << r.stats.max << '\n';
     }
-    
-    std::cout << "\n";
+    return true;
+}
+
+static bool exportJson(const std::string& path) {
+    std::ofstream out(path);
+    if (!out.is_open()) return false;
+
+    out << "[\n";
+    for (size_t i = 0; i < g_results.size(); ++i) {
+        const auto& r = g_results[i];
+        out << "  {\"name\":\"" << r.name << "\""
+            << ",\"unit\":\"" << r.unit << "\""
+            << ",\"samples\":" << r.stats.count
+            << ",\"min\":" << r.stats.min
+            << ",\"median\":" << r.stats.median
+            << ",\"mean\":" << r.stats.mean
+            << ",\"stddev\":" << r.stats.stddev
+            << ",\"p99\":" << r.stats.p99
+            << ",\"max\":" << r.stats.max
+            << "}" << (i + 1 < g_results.size() ? "," : "") << "\n";
+    }
+    out << "]\n";
+    return true;
 }
 
 // ============================================================================
 // Main Benchmark Runner
 // ============================================================================
-int main() {
-	SetupConsole() ;
+int main(int argc, char* argv[]) {
+    setupConsole();
+
+    std::string csv_path, json_path;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+
+        if (arg == "--csv" && i + 1 < argc) {
+            csv_path = argv[++i];
+        }
+        else if (arg == "--json" && i + 1 < argc) {
+            json_path = argv[++i];
+        }
+        else if (arg == "--quick") {
+            g_harness.warmup_trials = 1;
+            g_harness.trials = 3;
+        }
+        else if (arg == "--threads" && i + 1 < argc) {
+            g_harness.max_threads = std::stoul(argv[++i]);
+        }
+        else if (arg == "--help" || arg == "-h") {
+            std::cout << "Usage: grid_watcher_benchmark [OPTIONS]\n"
+                      << "  --csv <file>      Write results as CSV\n"
+                      << "  --json <file>     Write results as JSON\n"
+                      << "  --quick           Fewer trials (smoke test)\n"
+                      << "  --threads <n>     Cap scaling benchmarks at n threads\n";
+            return 0;
+        }
+    }
+
     std::cout << R"(
 ╔═══════════════════════════════════════════════════════════════════╗
 ║                                                                   ║
@@ -390,11 +633,13 @@ int main() {
 ║                                                                   ║
 ╚═══════════════════════════════════════════════════════════════════╝
 )" << std::endl;
-    
+
     std::cout << "System Information:\n";
     std::cout << "  CPU Cores:     " << std::thread::hardware_concurrency() << "\n";
     std::cout << "  Cache Line:    " << CACHE_LINE_SIZE << " bytes\n";
-    std::cout << "  Compiler:      " 
+    std::cout << "  Trials:        " << g_harness.trials
+              << " (+" << g_harness.warmup_trials << " warmup)\n";
+    std::cout << "  Compiler:      "
               #ifdef __clang__
               << "Clang " << __clang_version__
               #elif defined(__GNUC__)
@@ -403,24 +648,37 @@ int main() {
               << "Unknown"
               #endif
               << "\n\n";
-    
+
     std::cout << std::string(70, '=') << "\n";
-    
+
     try {
-        // Run all benchmarks
-        benchmarkPacketProcessingLatency();
-        benchmarkThroughput();
-        benchmarkMultiThreaded();
-        benchmarkMemoryUsage();
-        benchmarkScalability();
-        
-        std::cout << std::string(70, '=') << "\n";
+        benchmarkSubsystems();
+        benchmarkPacketLatency();
+        benchmarkScaling();
+
+        std::cout << "\n" << std::string(70, '=') << "\n";
+
+        if (!csv_path.empty()) {
+            if (exportCsv(csv_path)) {
+                std::cout << "Results written to " << csv_path << "\n";
+            } else {
+                std::cerr << "❌ Cannot write " << csv_path << "\n";
+            }
+        }
+        if (!json_path.empty()) {
+            if (exportJson(json_path)) {
+                std::cout << "Results written to " << json_path << "\n";
+            } else {
+                std::cerr << "❌ Cannot write " << json_path << "\n";
+            }
+        }
+
         std::cout << "\n✓ All benchmarks completed successfully!\n\n";
-        
+
     } catch (const std::exception& e) {
         std::cerr << "\n❌ Benchmark failed: " << e.what() << "\n";
         return 1;
     }
-    
+
     return 0;
 }
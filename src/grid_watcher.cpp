@@ -14,6 +14,10 @@
 
 #include "grid_watcher/grid_watcher.hpp"
 #include "grid_watcher/capture/packet_capture.hpp"
+#ifdef __linux__
+#include "grid_watcher/capture/mmap_capture.hpp"
+#include "grid_watcher/capture/pcap_replay.hpp"
+#endif
 #include <iostream>
 #include <string>
 #include <csignal>
@@ -24,8 +28,18 @@
 // Global state
 static std::atomic<bool> g_running{true};
 static gw::capture::PacketCapture* g_capture = nullptr;
+#ifdef __linux__
+static gw::capture::MmapCapture* g_mmap_capture = nullptr;
+#endif
 static gw::scada::GridWatcher* g_watcher = nullptr;
 
+// SIGHUP requests a config reload; applied from the main loop (a signal
+// handler must not touch the engine directly). g_startup_config holds the
+// values the process was launched with, so a reload reverts any runtime
+// tuning done through the API back to the operator's baseline.
+static volatile std::sig_atomic_t g_reload_requested = 0;
+static gw::scada::DetectionConfig g_startup_config;
+
 void setupConsole() {
 #ifdef _WIN32
     SetConsoleOutputCP(CP_UTF8);
@@ -53,10 +67,19 @@ void signalHandler(int) {
     if (g_running.exchange(false)) {
         std::cout << "\n\n[SIGNAL] Shutting down gracefully...\n";
         if (g_capture) g_capture->stop();
+#ifdef __linux__
+        if (g_mmap_capture) g_mmap_capture->stop();
+#endif
         if (g_watcher) g_watcher->stop();
     }
 }
 
+#ifdef SIGHUP
+void reloadHandler(int) {
+    g_reload_requested = 1;
+}
+#endif
+
 void printBanner() {
     std::cout << R"(
 ╔═══════════════════════════════════════════════════════════════╗
@@ -72,8 +95,9 @@ void clearScreen() {
     std::cout << "\033[2J\033[1;1H";
 }
 
-void updateDashboard(const gw::scada::GridWatcher& watcher, 
-                    const gw::capture::PacketCapture& capture,
+template<typename CaptureT>
+void updateDashboard(const gw::scada::GridWatcher& watcher,
+                    const CaptureT& capture,
                     int64_t uptime_sec) {
     auto stats = watcher.getStatistics();
     auto cap_stats = capture.getStats();
@@ -160,6 +184,13 @@ OPTIONS:
     --list-interfaces      List all available network interfaces
     --interface <name>     Capture on specific interface (default: any)
     --filter <bpf>        BPF filter (default: "tcp port 502")
+    --backend <name>      Capture backend: auto, mmap, pcap (default: auto)
+                          mmap = PACKET_MMAP/TPACKET_V3 ring (Linux only,
+                          zero-copy, falls back to pcap if unavailable)
+    --replay <file>       Replay a pcap/pcapng file offline instead of live
+                          capture (Linux only, memory-mapped zero-copy)
+    --paced               With --replay: honor recorded inter-packet gaps
+                          instead of replaying at full speed
     --help                Show this help message
 
 EXAMPLES:
@@ -175,6 +206,10 @@ EXAMPLES:
     # Capture all TCP traffic
     grid_watcher --filter "tcp"
 
+    # Replay an incident capture against current thresholds
+    grid_watcher --replay incident.pcap
+    grid_watcher --replay incident.pcapng --paced
+
 NOTES:
     - Requires Administrator/root privileges
     - Requires Npcap installed (Windows) or libpcap (Linux)
@@ -189,11 +224,14 @@ int main(int argc, char* argv[]) {
     // Parse arguments
     std::string interface_name = "any";
     std::string bpf_filter = "tcp port 502";
+    std::string backend = "auto";
+    std::string replay_file;
+    bool replay_paced = false;
     bool list_only = false;
-    
+
     for (int i = 1; i < argc; ++i) {
         std::string arg = argv[i];
-        
+
         if (arg == "--help" || arg == "-h") {
             printHelp();
             return 0;
@@ -207,6 +245,15 @@ int main(int argc, char* argv[]) {
         else if (arg == "--filter" && i + 1 < argc) {
             bpf_filter = argv[++i];
         }
+        else if (arg == "--backend" && i + 1 < argc) {
+            backend = argv[++i];
+        }
+        else if (arg == "--replay" && i + 1 < argc) {
+            replay_file = argv[++i];
+        }
+        else if (arg == "--paced") {
+            replay_paced = true;
+        }
     }
     
     // List interfaces only
@@ -218,6 +265,9 @@ int main(int argc, char* argv[]) {
     // Setup signal handlers
     std::signal(SIGINT, signalHandler);
     std::signal(SIGTERM, signalHandler);
+#ifdef SIGHUP
+    std::signal(SIGHUP, reloadHandler);
+#endif
     
     printBanner();
     
@@ -226,48 +276,119 @@ int main(int argc, char* argv[]) {
         auto config = gw::scada::DetectionConfig::createDefault();
         config.dos_packet_threshold = 500;
         config.port_scan_threshold = 10;
-        
+        g_startup_config = config;
+
         // Create Grid-Watcher
         g_watcher = new gw::scada::GridWatcher(config);
         g_watcher->start();
-        
-        // Create Packet Capture
-        g_capture = new gw::capture::PacketCapture(*g_watcher);
-        
-        if (!g_capture->start(interface_name, bpf_filter)) {
-            std::cerr << "\n[ERROR] Failed to start packet capture!\n";
-            std::cerr << "\n💡 Troubleshooting:\n";
-            std::cerr << "  1. Run as Administrator (Windows) or root (Linux)\n";
-            std::cerr << "  2. Install Npcap: https://npcap.com/\n";
-            std::cerr << "  3. Check interface name with: --list-interfaces\n\n";
-            
-            delete g_capture;
+
+        // Offline replay mode: run the capture file through the engine at
+        // full speed (or paced), report, and exit - no live capture setup
+        if (!replay_file.empty()) {
+#ifdef __linux__
+            gw::capture::PcapReplay replay(*g_watcher);
+            bool ok = replay.replay(replay_file, replay_paced);
+            g_watcher->stop();
+            delete g_watcher;
+            return ok ? 0 : 1;
+#else
+            std::cerr << "\n[ERROR] --replay is Linux-only\n";
             delete g_watcher;
             return 1;
+#endif
         }
-        
+
+        // Select capture backend: prefer the zero-copy mmap ring on Linux,
+        // fall back to libpcap gracefully
+        bool use_mmap = false;
+
+#ifdef __linux__
+        if (backend == "mmap" || backend == "auto") {
+            g_mmap_capture = new gw::capture::MmapCapture(*g_watcher);
+
+            if (g_mmap_capture->start(interface_name, bpf_filter)) {
+                use_mmap = true;
+            } else {
+                delete g_mmap_capture;
+                g_mmap_capture = nullptr;
+
+                if (backend == "mmap") {
+                    std::cerr << "\n[ERROR] mmap backend requested but unavailable!\n";
+                    delete g_watcher;
+                    return 1;
+                }
+                std::cout << "[INFO] mmap backend unavailable, falling back to pcap\n";
+            }
+        }
+#else
+        if (backend == "mmap") {
+            std::cerr << "\n[ERROR] mmap backend is Linux-only\n";
+            delete g_watcher;
+            return 1;
+        }
+#endif
+
+        if (!use_mmap) {
+            g_capture = new gw::capture::PacketCapture(*g_watcher);
+
+            if (!g_capture->start(interface_name, bpf_filter)) {
+                std::cerr << "\n[ERROR] Failed to start packet capture!\n";
+                std::cerr << "\n💡 Troubleshooting:\n";
+                std::cerr << "  1. Run as Administrator (Windows) or root (Linux)\n";
+                std::cerr << "  2. Install Npcap: https://npcap.com/\n";
+                std::cerr << "  3. Check interface name with: --list-interfaces\n\n";
+
+                delete g_capture;
+                delete g_watcher;
+                return 1;
+            }
+        }
+
         // Main loop
         auto start_time = std::chrono::steady_clock::now();
-        
+
         while (g_running) {
             std::this_thread::sleep_for(std::chrono::milliseconds(500));
-            
+
+            if (g_reload_requested) {
+                g_reload_requested = 0;
+                // RCU swap: workers pick up the baseline thresholds on
+                // their next packet, no restart and no analyzer state loss
+                if (g_watcher->reloadConfig(g_startup_config)) {
+                    std::cout << "\n[SIGNAL] Configuration reloaded\n";
+                } else {
+                    std::cout << "\n[SIGNAL] Configuration reload rejected\n";
+                }
+            }
+
             auto now = std::chrono::steady_clock::now();
             int64_t uptime = std::chrono::duration_cast<std::chrono::seconds>(
                 now - start_time
             ).count();
-            
+
+#ifdef __linux__
+            if (use_mmap) {
+                updateDashboard(*g_watcher, *g_mmap_capture, uptime);
+            } else {
+                updateDashboard(*g_watcher, *g_capture, uptime);
+            }
+#else
             updateDashboard(*g_watcher, *g_capture, uptime);
+#endif
         }
-        
+
         // Cleanup
         std::cout << "\n[INFO] Cleaning up...\n";
-        g_capture->stop();
-        g_watcher->stop();
-        
+        if (g_capture) g_capture->stop();
+#ifdef __linux__
+        if (g_mmap_capture) g_mmap_capture->stop();
+        delete g_mmap_capture;
+#endif
+        if (g_watcher) g_watcher->stop();
+
         delete g_capture;
         delete g_watcher;
-        
+
         std::cout << "[INFO] Shutdown complete.\n";
         
     } catch (const std::exception& e) {